@@ -0,0 +1,130 @@
+#include "bench.hpp"
+
+#include <gooselib/algorithm.hpp>
+#include <gooselib/array.hpp>
+#include <gooselib/utility.hpp>
+#include <gooselib/vector.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+    constexpr size_t kElements = 4096;
+
+    // Equal except for the very last element, so comparisons have to scan everything.
+    template<typename T>
+    struct comparePair {
+        goose::vector<T> a;
+        goose::vector<T> b;
+
+        comparePair() {
+            for (size_t i = 0; i < kElements; ++i) {
+                a.pushBack(static_cast<T>(i * 7));
+                b.pushBack(static_cast<T>(i * 7));
+            }
+            b.back() = static_cast<T>(b.back() + 1);
+        }
+    };
+}
+
+GOOSE_BENCH("algorithm/lexicographicalCompare_u8/goose") {
+    comparePair<unsigned char> data;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        bool less = goose::lexicographicalCompare(data.a.begin(), data.a.end(), data.b.begin(), data.b.end());
+        gooseBench::doNotOptimize(less);
+    }
+}
+
+GOOSE_BENCH("algorithm/lexicographicalCompare_u8/std") {
+    comparePair<unsigned char> data;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        bool less = std::lexicographical_compare(data.a.begin(), data.a.end(), data.b.begin(), data.b.end());
+        gooseBench::doNotOptimize(less);
+    }
+}
+
+GOOSE_BENCH("algorithm/lexicographicalCompare_i32/goose") {
+    comparePair<int> data;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        bool less = goose::lexicographicalCompare(data.a.begin(), data.a.end(), data.b.begin(), data.b.end());
+        gooseBench::doNotOptimize(less);
+    }
+}
+
+GOOSE_BENCH("algorithm/lexicographicalCompare_i32/std") {
+    comparePair<int> data;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        bool less = std::lexicographical_compare(data.a.begin(), data.a.end(), data.b.begin(), data.b.end());
+        gooseBench::doNotOptimize(less);
+    }
+}
+
+GOOSE_BENCH("algorithm/arrayLess/goose") {
+    goose::array<int, 256> a{};
+    goose::array<int, 256> b{};
+    b[255] = 1;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        bool less = a < b;
+        gooseBench::doNotOptimize(less);
+    }
+}
+
+GOOSE_BENCH("algorithm/find_i32/goose") {
+    comparePair<int> data;
+    int needle = data.b.back();
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        auto it = goose::find(data.b.begin(), data.b.end(), needle);
+        gooseBench::doNotOptimize(it);
+    }
+}
+
+GOOSE_BENCH("algorithm/find_i32/std") {
+    comparePair<int> data;
+    int needle = data.b.back();
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        auto it = std::find(data.b.begin(), data.b.end(), needle);
+        gooseBench::doNotOptimize(it);
+    }
+}
+
+GOOSE_BENCH("algorithm/count_i16/goose") {
+    comparePair<short> data;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        auto n = goose::count(data.a.begin(), data.a.end(), static_cast<short>(14));
+        gooseBench::doNotOptimize(n);
+    }
+}
+
+GOOSE_BENCH("algorithm/count_i16/std") {
+    comparePair<short> data;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        auto n = std::count(data.a.begin(), data.a.end(), static_cast<short>(14));
+        gooseBench::doNotOptimize(n);
+    }
+}
+
+GOOSE_BENCH("algorithm/saxpyIndexLoop/goose_numRange") {
+    goose::vector<float> x(kElements, 1.5f);
+    goose::vector<float> y(kElements, 0.5f);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        for (size_t j : goose::numRange<size_t>(kElements)) y[j] = 2.0f * x[j] + y[j];
+        gooseBench::clobberMemory();
+    }
+}
+
+GOOSE_BENCH("algorithm/saxpyIndexLoop/raw") {
+    goose::vector<float> x(kElements, 1.5f);
+    goose::vector<float> y(kElements, 0.5f);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        for (size_t j = 0; j < kElements; ++j) y[j] = 2.0f * x[j] + y[j];
+        gooseBench::clobberMemory();
+    }
+}
@@ -0,0 +1,102 @@
+#include "bench.hpp"
+
+#include <gooselib/memory.hpp>
+#include <gooselib/vector.hpp>
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr size_t kBatch = 256;
+
+    struct node {
+        node* next;
+        uint64_t payload[3];
+    };
+
+    // Allocates a batch of nodes and frees them again, the churn pattern of node-based containers.
+    template<typename Alloc>
+    void churn(Alloc& alloc, size_t iterations) {
+        node* live[kBatch];
+        for (size_t i = 0; i < iterations; ++i) {
+            for (auto& slot : live) slot = alloc.allocate(1);
+            gooseBench::doNotOptimize(live[kBatch - 1]);
+            for (auto& slot : live) alloc.deallocate(slot, 1);
+        }
+    }
+}
+
+GOOSE_BENCH("allocator/nodeChurn/goose_allocator") {
+    goose::allocator<node> alloc;
+    churn(alloc, state.iterations);
+}
+
+GOOSE_BENCH("allocator/nodeChurn/std_allocator") {
+    std::allocator<node> alloc;
+    churn(alloc, state.iterations);
+}
+
+GOOSE_BENCH("allocator/nodeChurn/goose_poolAllocator") {
+    goose::poolAllocator<node> alloc;
+    churn(alloc, state.iterations);
+}
+
+GOOSE_BENCH("allocator/scratchVectors/goose_allocator") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            goose::vector<int> scratch;
+            for (int k = 0; k < 64; ++k) scratch.pushBack(k);
+            gooseBench::doNotOptimize(scratch.data());
+        }
+    }
+}
+
+GOOSE_BENCH("allocator/scratchVectors/goose_arenaAllocator") {
+    alignas(std::max_align_t) std::byte buffer[16 * 1024];
+    goose::arena scratchArena(buffer, sizeof(buffer));
+    for (size_t i = 0; i < state.iterations; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            goose::vector<int, goose::arenaAllocator<int>> scratch{goose::arenaAllocator<int>(scratchArena)};
+            for (int k = 0; k < 64; ++k) scratch.pushBack(k);
+            gooseBench::doNotOptimize(scratch.data());
+        }
+        scratchArena.release();
+    }
+}
+
+GOOSE_BENCH("allocator/scratchVectors/std_allocator") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            std::vector<int> scratch;
+            for (int k = 0; k < 64; ++k) scratch.push_back(k);
+            gooseBench::doNotOptimize(scratch.data());
+        }
+    }
+}
+
+namespace {
+    constexpr size_t kTableEntries = size_t{8} << 20; // 64 MB of uint64_t
+
+    // Dependent random reads over a large table: every access misses the TLB unless the table
+    // sits on huge pages.
+    template<typename Vec>
+    void randomGather(Vec& table, size_t iterations) {
+        uint64_t index = 0;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            index = (index * 6364136223846793005ull + 1442695040888963407ull + table[index % kTableEntries]) >> 7;
+            sum += index;
+        }
+        gooseBench::doNotOptimize(sum);
+    }
+}
+
+// The tables are built during the first, one-iteration run and kept, so the timed runs only read.
+GOOSE_BENCH("allocator/largeRandomGather/goose_allocator") {
+    static goose::vector<uint64_t> table(kTableEntries);
+    randomGather(table, state.iterations);
+}
+
+GOOSE_BENCH("allocator/largeRandomGather/goose_hugePageAllocator") {
+    static goose::vector<uint64_t, goose::hugePageAllocator<uint64_t>> table(kTableEntries);
+    randomGather(table, state.iterations);
+}
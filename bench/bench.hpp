@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gooseBench {
+    // Handed to every benchmark body, which must run its measured operation `iterations` times.
+    struct state {
+        size_t iterations;
+    };
+
+    using benchFunction = void (*)(state&);
+
+    void registerBenchmark(const char* name, benchFunction fn);
+
+    struct registrar {
+        registrar(const char* name, benchFunction fn) { registerBenchmark(name, fn); }
+    };
+
+    // Keeps the compiler from discarding a computed value or hoisting it out of the loop.
+    template<typename T>
+    inline void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline void clobberMemory() {
+        asm volatile("" : : : "memory");
+    }
+
+    // Global operator new/delete in bench_main.cpp feed these counters.
+    uint64_t allocationCount();
+    uint64_t allocatedBytes();
+}
+
+#define GOOSE_BENCH_CONCAT_(a, b) a##b
+#define GOOSE_BENCH_CONCAT(a, b) GOOSE_BENCH_CONCAT_(a, b)
+
+// Defines and registers a benchmark: GOOSE_BENCH("vector/pushBack/goose") { for (...) }
+#define GOOSE_BENCH(name)                                                                                        \
+    static void GOOSE_BENCH_CONCAT(gooseBenchFn, __LINE__)(gooseBench::state&);                                  \
+    static gooseBench::registrar GOOSE_BENCH_CONCAT(gooseBenchReg, __LINE__)(name, GOOSE_BENCH_CONCAT(gooseBenchFn, __LINE__)); \
+    static void GOOSE_BENCH_CONCAT(gooseBenchFn, __LINE__)([[maybe_unused]] gooseBench::state& state)
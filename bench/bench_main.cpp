@@ -0,0 +1,115 @@
+#include "bench.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+    std::atomic<uint64_t> gAllocations{0};
+    std::atomic<uint64_t> gAllocatedBytes{0};
+
+    struct entry {
+        const char* name;
+        gooseBench::benchFunction fn;
+    };
+
+    std::vector<entry>& registry() {
+        static std::vector<entry> entries;
+        return entries;
+    }
+
+    void* countedAllocate(size_t size, size_t align) {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+        gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        void* ptr = align > alignof(std::max_align_t) ? std::aligned_alloc(align, (size + align - 1) / align * align)
+                                                      : std::malloc(size);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+
+    void printEscaped(const char* text) {
+        for (; *text; ++text) {
+            if (*text == '"' || *text == '\\') std::putchar('\\');
+            std::putchar(*text);
+        }
+    }
+}
+
+void* operator new(size_t size) { return countedAllocate(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size) { return countedAllocate(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, std::align_val_t align) { return countedAllocate(size, static_cast<size_t>(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return countedAllocate(size, static_cast<size_t>(align)); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+namespace gooseBench {
+    void registerBenchmark(const char* name, benchFunction fn) { registry().push_back({name, fn}); }
+    uint64_t allocationCount() { return gAllocations.load(std::memory_order_relaxed); }
+    uint64_t allocatedBytes() { return gAllocatedBytes.load(std::memory_order_relaxed); }
+}
+
+// Usage: gooselib_bench [--filter SUBSTRING] [--min-time MILLISECONDS]
+// Prints one JSON document with a result object per benchmark.
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    double minSeconds = 0.1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (!std::strcmp(argv[i], "--min-time") && i + 1 < argc) {
+            minSeconds = std::atof(argv[++i]) / 1000.0;
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter SUBSTRING] [--min-time MILLISECONDS]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    using clock = std::chrono::steady_clock;
+    std::printf("{\n  \"benchmarks\": [");
+    bool first = true;
+    for (const entry& bench : registry()) {
+        if (filter && !std::strstr(bench.name, filter)) continue;
+
+        // Grow the iteration count until one run lasts long enough to time reliably.
+        gooseBench::state state{1};
+        double seconds = 0;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        while (true) {
+            uint64_t allocationsBefore = gooseBench::allocationCount();
+            uint64_t bytesBefore = gooseBench::allocatedBytes();
+            auto start = clock::now();
+            bench.fn(state);
+            seconds = std::chrono::duration<double>(clock::now() - start).count();
+            allocations = gooseBench::allocationCount() - allocationsBefore;
+            bytes = gooseBench::allocatedBytes() - bytesBefore;
+            if (seconds >= minSeconds || state.iterations >= (size_t{1} << 40)) break;
+            double scale = seconds > 0 ? minSeconds / seconds * 1.2 : 100.0;
+            if (scale > 100.0) scale = 100.0;
+            if (scale < 2.0) scale = 2.0;
+            state.iterations = static_cast<size_t>(state.iterations * scale);
+        }
+
+        double iterations = static_cast<double>(state.iterations);
+        std::printf("%s\n    {\"name\": \"", first ? "" : ",");
+        printEscaped(bench.name);
+        std::printf("\", \"iterations\": %zu, \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f, \"bytes_per_op\": %.2f}",
+                    state.iterations, seconds * 1e9 / iterations, allocations / iterations, bytes / iterations);
+        std::fflush(stdout);
+        first = false;
+    }
+    std::printf("\n  ]\n}\n");
+    return 0;
+}
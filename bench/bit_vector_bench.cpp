@@ -0,0 +1,149 @@
+#include "bench.hpp"
+
+#include <gooselib/bit_vector.hpp>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+namespace {
+    constexpr size_t kBits = 1 << 16;
+
+    // Every third bit and a few scattered ones, so neither all-zero nor all-one words dominate.
+    bool patternBit(size_t i) { return i % 3 == 0 || (i * 2654435761u) % 17 == 0; }
+
+    template<typename Bits>
+    void fillPattern(Bits& bits) {
+        for (size_t i = 0; i < kBits; ++i) bits[i] = patternBit(i);
+    }
+
+    const goose::bitVector<>& gooseBits() {
+        static goose::bitVector<> bits = [] {
+            goose::bitVector<> b(kBits);
+            fillPattern(b);
+            return b;
+        }();
+        return bits;
+    }
+
+    const std::bitset<kBits>& stdBits() {
+        static std::bitset<kBits> bits = [] {
+            std::bitset<kBits> b;
+            fillPattern(b);
+            return b;
+        }();
+        return bits;
+    }
+
+    const std::vector<bool>& stdVectorBool() {
+        static std::vector<bool> bits = [] {
+            std::vector<bool> b(kBits);
+            for (size_t i = 0; i < kBits; ++i) b[i] = patternBit(i);
+            return b;
+        }();
+        return bits;
+    }
+}
+
+GOOSE_BENCH("bit_vector/count64K/goose_bitVector") {
+    const auto& bits = gooseBits();
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        sum += bits.count();
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("bit_vector/count64K/std_bitset") {
+    const auto& bits = stdBits();
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        sum += bits.count();
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("bit_vector/count64K/std_vector_bool") {
+    const auto& bits = stdVectorBool();
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        for (bool b : bits) sum += b;
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("bit_vector/and64K/goose_bitVector") {
+    goose::bitVector<> acc(kBits, true);
+    const auto& bits = gooseBits();
+    for (size_t i = 0; i < state.iterations; ++i) {
+        acc &= bits;
+        gooseBench::clobberMemory();
+    }
+    gooseBench::doNotOptimize(acc.data());
+}
+
+GOOSE_BENCH("bit_vector/and64K/std_bitset") {
+    static std::bitset<kBits> acc;
+    acc.set();
+    const auto& bits = stdBits();
+    for (size_t i = 0; i < state.iterations; ++i) {
+        acc &= bits;
+        gooseBench::clobberMemory();
+    }
+    gooseBench::doNotOptimize(acc);
+}
+
+GOOSE_BENCH("bit_vector/iterateSet64K/goose_bitVector") {
+    const auto& bits = gooseBits();
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        for (size_t pos = bits.findFirst(); pos < kBits; pos = bits.findNext(pos)) sum += pos;
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("bit_vector/iterateSet64K/goose_forEachSet") {
+    const auto& bits = gooseBits();
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) bits.forEachSet([&](size_t pos) { sum += pos; });
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("bit_vector/iterateSet64K/std_bitset") {
+    const auto& bits = stdBits();
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        for (size_t pos = bits._Find_first(); pos < kBits; pos = bits._Find_next(pos)) sum += pos;
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("bit_vector/rank/goose_rankSelectIndex") {
+    static goose::rankSelectIndex index(gooseBits());
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) sum += index.rank1((i * 40503) & (kBits - 1));
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("bit_vector/rank/popcount_scan") {
+    const auto& bits = gooseBits();
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        size_t pos = (i * 40503) & (kBits - 1);
+        const uint64_t* words = bits.data();
+        size_t rank = 0;
+        for (size_t w = 0; w < pos / 64; ++w) rank += static_cast<size_t>(goose::_implementation::_popcount(words[w]));
+        sum += rank + static_cast<size_t>(goose::_implementation::_popcount(words[pos / 64] & ((uint64_t{1} << (pos % 64)) - 1)));
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("bit_vector/select/goose_rankSelectIndex") {
+    static goose::rankSelectIndex index(gooseBits());
+    size_t ones = index.ones();
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) sum += index.select1((i * 40503) % ones);
+    gooseBench::doNotOptimize(sum);
+}
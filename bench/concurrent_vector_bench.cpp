@@ -0,0 +1,58 @@
+#include "bench.hpp"
+
+#include <gooselib/concurrent_vector.hpp>
+#include <gooselib/vector.hpp>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace {
+    // Threads append iterations values in total to one shared container; ns_per_op is the cost
+    // per append with all of them running.
+    template<size_t Threads, typename Append>
+    void appendFromThreads(size_t iterations, Append append) {
+        goose::vector<std::thread> threads;
+        threads.reserve(Threads);
+        for (size_t t = 0; t < Threads; ++t) {
+            threads.emplaceBack([&append, iterations, t] {
+                for (size_t i = t; i < iterations; i += Threads) append(static_cast<uint64_t>(i));
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    }
+
+    template<size_t Threads>
+    void concurrentAppend(size_t iterations) {
+        goose::concurrentVector<uint64_t> values;
+        appendFromThreads<Threads>(iterations, [&](uint64_t value) { values.pushBack(value); });
+        gooseBench::doNotOptimize(values.size());
+    }
+
+    // The baseline: one lock around a vector that reallocates as it grows.
+    template<size_t Threads>
+    void mutexAppend(size_t iterations) {
+        std::mutex lock;
+        goose::vector<uint64_t> values;
+        appendFromThreads<Threads>(iterations, [&](uint64_t value) {
+            std::lock_guard<std::mutex> guard(lock);
+            values.pushBack(value);
+        });
+        gooseBench::doNotOptimize(values.size());
+    }
+}
+
+GOOSE_BENCH("concurrentVector/append1/goose_concurrentVector") { concurrentAppend<1>(state.iterations); }
+GOOSE_BENCH("concurrentVector/append1/mutex_vector") { mutexAppend<1>(state.iterations); }
+GOOSE_BENCH("concurrentVector/append4/goose_concurrentVector") { concurrentAppend<4>(state.iterations); }
+GOOSE_BENCH("concurrentVector/append4/mutex_vector") { mutexAppend<4>(state.iterations); }
+
+GOOSE_BENCH("concurrentVector/indexedRead/goose_concurrentVector") {
+    static goose::concurrentVector<uint64_t> values = [] {
+        goose::concurrentVector<uint64_t> result;
+        for (uint64_t i = 0; i < 4096; ++i) result.pushBack(i);
+        return result;
+    }();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) sum += values[i & 4095];
+    gooseBench::doNotOptimize(sum);
+}
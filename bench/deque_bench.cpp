@@ -0,0 +1,50 @@
+#include "bench.hpp"
+
+#include <gooselib/deque.hpp>
+#include <cstdint>
+#include <deque>
+
+namespace {
+    constexpr size_t kWindow = 4096;
+
+    // A sliding window: every step pushes one value at the back and retires one at the front.
+    template<typename Deque, typename PushBack, typename PopFront>
+    void slidingWindow(size_t iterations, PushBack pushBack, PopFront popFront) {
+        Deque window;
+        for (uint64_t i = 0; i < kWindow; ++i) pushBack(window, i);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            pushBack(window, static_cast<uint64_t>(i));
+            sum += window.front();
+            popFront(window);
+        }
+        gooseBench::doNotOptimize(sum);
+    }
+
+    template<typename Deque>
+    void indexedRead(const Deque& values, size_t iterations) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < iterations; ++i) sum += values[(i * 7) & (kWindow - 1)];
+        gooseBench::doNotOptimize(sum);
+    }
+}
+
+GOOSE_BENCH("deque/slidingWindow/goose_deque") {
+    slidingWindow<goose::deque<uint64_t>>(
+        state.iterations, [](auto& d, uint64_t v) { d.pushBack(v); }, [](auto& d) { d.popFront(); });
+}
+
+GOOSE_BENCH("deque/slidingWindow/std_deque") {
+    slidingWindow<std::deque<uint64_t>>(
+        state.iterations, [](auto& d, uint64_t v) { d.push_back(v); }, [](auto& d) { d.pop_front(); });
+}
+
+GOOSE_BENCH("deque/indexedRead/goose_deque") {
+    static goose::deque<uint64_t> values(kWindow, uint64_t{1});
+    indexedRead(values, state.iterations);
+}
+
+GOOSE_BENCH("deque/indexedRead/std_deque") {
+    static std::deque<uint64_t> values(kWindow, uint64_t{1});
+    indexedRead(values, state.iterations);
+}
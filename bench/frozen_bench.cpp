@@ -0,0 +1,134 @@
+#include "bench.hpp"
+
+#include <gooselib/algorithm.hpp>
+#include <gooselib/array.hpp>
+#include <gooselib/flat_hash_map.hpp>
+#include <gooselib/frozen.hpp>
+#include <gooselib/sort.hpp>
+#include <cstdint>
+#include <string_view>
+
+namespace {
+    constexpr std::string_view kMethods[] = {
+        "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH",
+    };
+
+    constexpr auto kFrozenMethods = goose::makeFrozenMap<std::string_view, int>({
+        {"GET", 1}, {"HEAD", 2}, {"POST", 3}, {"PUT", 4}, {"DELETE", 5},
+        {"CONNECT", 6}, {"OPTIONS", 7}, {"TRACE", 8}, {"PATCH", 9},
+    });
+
+    // Probes cycle through every method plus one miss.
+    constexpr std::string_view kProbes[] = {
+        "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH", "BREW",
+    };
+    constexpr size_t kProbeCount = sizeof(kProbes) / sizeof(kProbes[0]);
+
+    int ifChain(std::string_view method) {
+        if (method == "GET") return 1;
+        if (method == "HEAD") return 2;
+        if (method == "POST") return 3;
+        if (method == "PUT") return 4;
+        if (method == "DELETE") return 5;
+        if (method == "CONNECT") return 6;
+        if (method == "OPTIONS") return 7;
+        if (method == "TRACE") return 8;
+        if (method == "PATCH") return 9;
+        return 0;
+    }
+
+    // A sparse 16-bit opcode space with 96 defined opcodes.
+    constexpr size_t kOpcodes = 96;
+
+    constexpr uint16_t opcodeAt(size_t i) { return static_cast<uint16_t>(i * 613 + 7); }
+
+    template<size_t... I>
+    constexpr auto makeOpcodeTable(std::index_sequence<I...>) {
+        return goose::makeFrozenMap<uint16_t, uint32_t>({{opcodeAt(I), static_cast<uint32_t>(I)}...});
+    }
+
+    constexpr auto kFrozenOpcodes = makeOpcodeTable(std::make_index_sequence<kOpcodes>{});
+
+    constexpr goose::array<uint16_t, kOpcodes> makeSortedOpcodes() {
+        goose::array<uint16_t, kOpcodes> sorted{};
+        for (size_t i = 0; i < kOpcodes; ++i) sorted[i] = opcodeAt(kOpcodes - 1 - i);
+        goose::sort(sorted.begin(), sorted.end());
+        return sorted;
+    }
+
+    constexpr auto kSortedOpcodes = makeSortedOpcodes();
+
+    // Three hits for every miss, in a scrambled order.
+    uint16_t opcodeProbe(size_t i) {
+        size_t k = (i * 37) % (kOpcodes + kOpcodes / 3);
+        return k < kOpcodes ? opcodeAt(k) : static_cast<uint16_t>(opcodeAt(k - kOpcodes) + 1);
+    }
+
+    struct stringViewHash {
+        size_t operator()(std::string_view s) const noexcept { return goose::frozenHash<std::string_view>{}(s); }
+    };
+}
+
+GOOSE_BENCH("frozen/methodLookup/goose_frozenMap") {
+    int sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::string_view probe = kProbes[i % kProbeCount];
+        gooseBench::doNotOptimize(probe);
+        auto it = kFrozenMethods.find(probe);
+        if (it != kFrozenMethods.end()) sum += it->value;
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("frozen/methodLookup/goose_flatHashMap") {
+    goose::flatHashMap<std::string_view, int, stringViewHash> map;
+    for (size_t i = 0; i < sizeof(kMethods) / sizeof(kMethods[0]); ++i) map[kMethods[i]] = static_cast<int>(i) + 1;
+    int sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::string_view probe = kProbes[i % kProbeCount];
+        gooseBench::doNotOptimize(probe);
+        auto it = map.find(probe);
+        if (it != map.end()) sum += it->second;
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("frozen/methodLookup/ifChain") {
+    int sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::string_view probe = kProbes[i % kProbeCount];
+        gooseBench::doNotOptimize(probe);
+        sum += ifChain(probe);
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("frozen/opcodeLookup/goose_frozenMap") {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        auto it = kFrozenOpcodes.find(opcodeProbe(i));
+        if (it != kFrozenOpcodes.end()) sum += it->value;
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("frozen/opcodeLookup/goose_constexprSortedArray") {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        uint16_t probe = opcodeProbe(i);
+        auto it = goose::lowerBound(kSortedOpcodes.begin(), kSortedOpcodes.end(), probe);
+        if (it != kSortedOpcodes.end() && *it == probe) sum += static_cast<uint32_t>(it - kSortedOpcodes.begin());
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("frozen/opcodeLookup/goose_flatHashMap") {
+    goose::flatHashMap<uint16_t, uint32_t> map;
+    for (size_t i = 0; i < kOpcodes; ++i) map[opcodeAt(i)] = static_cast<uint32_t>(i);
+    uint32_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        auto it = map.find(opcodeProbe(i));
+        if (it != map.end()) sum += it->second;
+    }
+    gooseBench::doNotOptimize(sum);
+}
@@ -0,0 +1,72 @@
+#include "bench.hpp"
+
+#include <gooselib/flat_hash_map.hpp>
+#include <gooselib/vector.hpp>
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+    constexpr size_t kEntries = 1 << 16;
+
+    goose::vector<uint64_t> makeKeys() {
+        goose::vector<uint64_t> keys;
+        keys.reserve(kEntries);
+        uint64_t state = 0x2545F4914F6CDD1Dull;
+        for (size_t i = 0; i < kEntries; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            keys.pushBack(state);
+        }
+        return keys;
+    }
+
+    const goose::vector<uint64_t>& keys() {
+        static const goose::vector<uint64_t> values = makeKeys();
+        return values;
+    }
+
+    // Half of the probes hit, half miss, walking the keys in insertion order.
+    template<typename Map>
+    void lookup(const Map& map, size_t iterations) {
+        const auto& k = keys();
+        uint64_t sum = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            uint64_t key = k[i % kEntries] + (i & 1);
+            auto it = map.find(key);
+            if (it != map.end()) sum += it->second;
+        }
+        gooseBench::doNotOptimize(sum);
+    }
+
+    template<typename Map>
+    void insert(size_t iterations) {
+        const auto& k = keys();
+        for (size_t i = 0; i < iterations; ++i) {
+            Map map;
+            map.reserve(kEntries);
+            for (uint64_t key : k) map[key] = key;
+            gooseBench::doNotOptimize(map);
+        }
+    }
+}
+
+GOOSE_BENCH("hashMap/lookup/goose_flatHashMap") {
+    goose::flatHashMap<uint64_t, uint64_t> map;
+    for (uint64_t key : keys()) map[key] = key;
+    lookup(map, state.iterations);
+}
+
+GOOSE_BENCH("hashMap/lookup/std_unorderedMap") {
+    std::unordered_map<uint64_t, uint64_t> map;
+    for (uint64_t key : keys()) map[key] = key;
+    lookup(map, state.iterations);
+}
+
+GOOSE_BENCH("hashMap/insertReserved/goose_flatHashMap") {
+    insert<goose::flatHashMap<uint64_t, uint64_t>>(state.iterations);
+}
+
+GOOSE_BENCH("hashMap/insertReserved/std_unorderedMap") {
+    insert<std::unordered_map<uint64_t, uint64_t>>(state.iterations);
+}
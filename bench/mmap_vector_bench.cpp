@@ -0,0 +1,59 @@
+#include "bench.hpp"
+
+#include <gooselib/mmap_vector.hpp>
+#include <gooselib/vector.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace {
+    constexpr size_t kRecords = 1 << 20;
+
+    struct record {
+        uint64_t id;
+        double price;
+        uint32_t quantity;
+        char tag[12];
+    };
+
+    // 32 MB of records, written once per run into a temporary file.
+    const std::string& datasetPath() {
+        static const std::string path = [] {
+            std::string p = "/tmp/gooselib_bench_" + std::to_string(::getpid()) + ".mmv";
+            goose::mmapVector<record> out(p.c_str(), goose::mmapMode::readWrite);
+            out.reserve(kRecords);
+            for (size_t i = 0; i < kRecords; ++i) out.pushBack({i, i * 0.25, static_cast<uint32_t>(i), {}});
+            return p;
+        }();
+        return path;
+    }
+
+    struct datasetCleanup {
+        ~datasetCleanup() { ::unlink(datasetPath().c_str()); }
+    };
+}
+
+// Opening the file and reading one record: the cost of making the dataset available.
+GOOSE_BENCH("mmapVector/openDataset/goose_mmapVector") {
+    static datasetCleanup cleanup;
+    const char* path = datasetPath().c_str();
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::mmapVector<record> data(path);
+        gooseBench::doNotOptimize(data[data.size() / 2].id);
+    }
+}
+
+// The read-and-copy loader mmapVector replaces.
+GOOSE_BENCH("mmapVector/openDataset/freadIntoVector") {
+    static datasetCleanup cleanup;
+    const char* path = datasetPath().c_str();
+    for (size_t i = 0; i < state.iterations; ++i) {
+        FILE* file = std::fopen(path, "rb");
+        std::fseek(file, 64, SEEK_SET); // past the mmapVector header
+        goose::vector<record> data(kRecords);
+        size_t read = std::fread(data.data(), sizeof(record), kRecords, file);
+        std::fclose(file);
+        gooseBench::doNotOptimize(data[read / 2].id);
+    }
+}
@@ -0,0 +1,54 @@
+#include "bench.hpp"
+
+#include <gooselib/optional.hpp>
+#include <gooselib/vector.hpp>
+#include <optional>
+#include <vector>
+
+namespace {
+    constexpr size_t kElements = 1024;
+}
+
+GOOSE_BENCH("optional/access/goose") {
+    goose::vector<goose::optional<long long>> values;
+    for (size_t i = 0; i < kElements; ++i) {
+        values.pushBack(i % 4 ? goose::optional<long long>(static_cast<long long>(i)) : goose::optional<long long>());
+    }
+    for (size_t i = 0; i < state.iterations; ++i) {
+        long long sum = 0;
+        for (const auto& value : values) {
+            if (value) sum += *value;
+        }
+        gooseBench::doNotOptimize(sum);
+    }
+}
+
+GOOSE_BENCH("optional/access/std") {
+    std::vector<std::optional<long long>> values;
+    for (size_t i = 0; i < kElements; ++i) {
+        values.push_back(i % 4 ? std::optional<long long>(static_cast<long long>(i)) : std::nullopt);
+    }
+    for (size_t i = 0; i < state.iterations; ++i) {
+        long long sum = 0;
+        for (const auto& value : values) {
+            if (value) sum += *value;
+        }
+        gooseBench::doNotOptimize(sum);
+    }
+}
+
+GOOSE_BENCH("optional/copy/goose") {
+    goose::optional<long long> source(42LL);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::optional<long long> copy(source);
+        gooseBench::doNotOptimize(copy);
+    }
+}
+
+GOOSE_BENCH("optional/copy/std") {
+    std::optional<long long> source(42LL);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::optional<long long> copy(source);
+        gooseBench::doNotOptimize(copy);
+    }
+}
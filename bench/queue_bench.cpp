@@ -0,0 +1,184 @@
+#include "bench.hpp"
+
+#include <gooselib/mpmc_queue.hpp>
+#include <gooselib/spsc_queue.hpp>
+#include <gooselib/vector.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Waiting sides yield instead of spinning hard, so the numbers stay meaningful when the
+// machine has fewer cores than the benchmark has threads.
+namespace {
+    // Streams iterations items from a producer thread to the calling thread; ns_per_op is the
+    // cost per item with both threads running flat out.
+    template<typename Queue, size_t Batch>
+    void spscStream(size_t iterations) {
+        static Queue queue;
+        std::thread producer([iterations] {
+            uint64_t buffer[Batch];
+            uint64_t next = 0;
+            while (next < iterations) {
+                size_t count = iterations - next < Batch ? iterations - next : Batch;
+                for (size_t i = 0; i < count; ++i) buffer[i] = next + i;
+                size_t pushed = Batch == 1 ? queue.tryPush(buffer[0]) : queue.tryPushN(buffer, count);
+                if (pushed == 0) std::this_thread::yield();
+                next += pushed;
+            }
+        });
+        uint64_t buffer[Batch];
+        uint64_t received = 0;
+        uint64_t sum = 0;
+        while (received < iterations) {
+            size_t count = Batch == 1 ? queue.tryPop(buffer[0]) : queue.tryPopN(buffer, Batch);
+            if (count == 0) std::this_thread::yield();
+            for (size_t i = 0; i < count; ++i) sum += buffer[i];
+            received += count;
+        }
+        producer.join();
+        gooseBench::doNotOptimize(sum);
+    }
+
+    // The job-queue baseline: one lock around a std::deque, consumers sleeping on a condition variable.
+    struct mutexDequeQueue {
+        std::mutex lock;
+        std::condition_variable notEmpty;
+        std::deque<uint64_t> items;
+
+        void push(uint64_t value) {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                items.push_back(value);
+            }
+            notEmpty.notify_one();
+        }
+
+        uint64_t pop() {
+            std::unique_lock<std::mutex> guard(lock);
+            notEmpty.wait(guard, [this] { return !items.empty(); });
+            uint64_t value = items.front();
+            items.pop_front();
+            return value;
+        }
+    };
+
+    // Threads is split evenly into producers and consumers that move iterations items in total
+    // through one queue with blocking push and pop.
+    template<typename Queue, size_t Threads>
+    void mpmcContention(Queue& queue, size_t iterations) {
+        constexpr size_t producers = Threads / 2;
+        constexpr size_t consumers = Threads - producers;
+        goose::vector<std::thread> threads;
+        threads.reserve(Threads);
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplaceBack([&queue, iterations, p] {
+                for (size_t i = p; i < iterations; i += producers) queue.push(i);
+            });
+        }
+        std::atomic<uint64_t> total{0};
+        for (size_t c = 0; c < consumers; ++c) {
+            threads.emplaceBack([&queue, &total, iterations, c] {
+                uint64_t sum = 0;
+                for (size_t i = c; i < iterations; i += consumers) sum += queue.pop();
+                total.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        gooseBench::doNotOptimize(total);
+    }
+}
+
+GOOSE_BENCH("queue/spscThroughput/goose_single") {
+    spscStream<goose::spscQueue<uint64_t, 4096>, 1>(state.iterations);
+}
+
+GOOSE_BENCH("queue/spscThroughput/goose_batch64") {
+    spscStream<goose::spscQueue<uint64_t, 4096>, 64>(state.iterations);
+}
+
+GOOSE_BENCH("queue/spscThroughput/std_mutexDeque") {
+    std::mutex lock;
+    std::deque<uint64_t> queue;
+    size_t iterations = state.iterations;
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            std::lock_guard<std::mutex> guard(lock);
+            queue.push_back(i);
+        }
+    });
+    uint64_t received = 0;
+    uint64_t sum = 0;
+    while (received < iterations) {
+        std::lock_guard<std::mutex> guard(lock);
+        while (!queue.empty()) {
+            sum += queue.front();
+            queue.pop_front();
+            ++received;
+        }
+    }
+    producer.join();
+    gooseBench::doNotOptimize(sum);
+}
+
+// One op is a full round trip: ping to the echo thread and wait for its pong.
+GOOSE_BENCH("queue/spscRoundTrip/goose") {
+    static goose::spscQueue<uint64_t, 64> ping;
+    static goose::spscQueue<uint64_t, 64> pong;
+    size_t iterations = state.iterations;
+    std::thread echo([iterations] {
+        uint64_t value;
+        for (size_t i = 0; i < iterations; ++i) {
+            while (!ping.tryPop(value)) std::this_thread::yield();
+            while (!pong.tryPush(value)) std::this_thread::yield();
+        }
+    });
+    uint64_t value = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        while (!ping.tryPush(i)) std::this_thread::yield();
+        while (!pong.tryPop(value)) std::this_thread::yield();
+    }
+    echo.join();
+    gooseBench::doNotOptimize(value);
+}
+
+GOOSE_BENCH("queue/mpmcContention/goose_2threads") {
+    goose::mpmcQueue<uint64_t> queue(1024);
+    mpmcContention<decltype(queue), 2>(queue, state.iterations);
+}
+
+GOOSE_BENCH("queue/mpmcContention/goose_4threads") {
+    goose::mpmcQueue<uint64_t> queue(1024);
+    mpmcContention<decltype(queue), 4>(queue, state.iterations);
+}
+
+GOOSE_BENCH("queue/mpmcContention/goose_8threads") {
+    goose::mpmcQueue<uint64_t> queue(1024);
+    mpmcContention<decltype(queue), 8>(queue, state.iterations);
+}
+
+GOOSE_BENCH("queue/mpmcContention/goose_16threads") {
+    goose::mpmcQueue<uint64_t> queue(1024);
+    mpmcContention<decltype(queue), 16>(queue, state.iterations);
+}
+
+GOOSE_BENCH("queue/mpmcContention/std_mutexDeque_2threads") {
+    mutexDequeQueue queue;
+    mpmcContention<decltype(queue), 2>(queue, state.iterations);
+}
+
+GOOSE_BENCH("queue/mpmcContention/std_mutexDeque_4threads") {
+    mutexDequeQueue queue;
+    mpmcContention<decltype(queue), 4>(queue, state.iterations);
+}
+
+GOOSE_BENCH("queue/mpmcContention/std_mutexDeque_8threads") {
+    mutexDequeQueue queue;
+    mpmcContention<decltype(queue), 8>(queue, state.iterations);
+}
+
+GOOSE_BENCH("queue/mpmcContention/std_mutexDeque_16threads") {
+    mutexDequeQueue queue;
+    mpmcContention<decltype(queue), 16>(queue, state.iterations);
+}
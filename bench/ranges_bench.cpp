@@ -0,0 +1,53 @@
+#include "bench.hpp"
+
+#include <gooselib/ranges.hpp>
+#include <gooselib/vector.hpp>
+#include <cstdint>
+
+namespace {
+    constexpr size_t kRecords = 1 << 14;
+
+    const goose::vector<int32_t>& records() {
+        static const goose::vector<int32_t> values = [] {
+            goose::vector<int32_t> v;
+            v.reserve(kRecords);
+            uint32_t state = 12345;
+            for (size_t i = 0; i < kRecords; ++i) {
+                state = state * 1664525u + 1013904223u;
+                v.pushBack(static_cast<int32_t>(state >> 8) - (1 << 23));
+            }
+            return v;
+        }();
+        return values;
+    }
+
+    bool isPositive(int32_t value) { return value > 0; }
+    int64_t scale(int32_t value) { return int64_t{value} * 3 + 1; }
+}
+
+// filter -> transform -> drop -> sum, one temporary vector per stage.
+GOOSE_BENCH("ranges/filterTransformSum/goose_materialized") {
+    const auto& input = records();
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::vector<int32_t> filtered;
+        for (int32_t value : input) {
+            if (isPositive(value)) filtered.pushBack(value);
+        }
+        goose::vector<int64_t> scaled;
+        scaled.reserve(filtered.size());
+        for (int32_t value : filtered) scaled.pushBack(scale(value));
+        int64_t total = 0;
+        for (size_t j = 16; j < scaled.size(); ++j) total += scaled[j];
+        gooseBench::doNotOptimize(total);
+    }
+}
+
+GOOSE_BENCH("ranges/filterTransformSum/goose_views") {
+    const auto& input = records();
+    auto view = input | goose::views::filter(isPositive) | goose::views::transform(scale) | goose::views::drop(16);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        int64_t total = 0;
+        for (int64_t value : view) total += value;
+        gooseBench::doNotOptimize(total);
+    }
+}
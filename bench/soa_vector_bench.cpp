@@ -0,0 +1,51 @@
+#include "bench.hpp"
+
+#include <gooselib/algorithm.hpp>
+#include <gooselib/soa_vector.hpp>
+#include <gooselib/vector.hpp>
+#include <cstdint>
+
+namespace {
+    constexpr size_t kRows = 1 << 16;
+
+    // A wide record where the scan below only reads one field.
+    struct particle {
+        double x, y, z;
+        double vx, vy, vz;
+        float mass;
+        uint32_t flags;
+    };
+
+    using particleColumns = goose::soaVector<double, double, double, double, double, double, float, uint32_t>;
+}
+
+GOOSE_BENCH("soaVector/scanOneField/goose_vectorOfStructs") {
+    goose::vector<particle> particles;
+    particles.reserve(kRows);
+    for (size_t i = 0; i < kRows; ++i) particles.pushBack({double(i), 0, 0, 0, 0, 0, float(i & 7), 0});
+    for (size_t i = 0; i < state.iterations; ++i) {
+        double total = 0;
+        for (const auto& p : particles) total += p.mass;
+        gooseBench::doNotOptimize(total);
+    }
+}
+
+GOOSE_BENCH("soaVector/scanOneField/goose_soaVector") {
+    particleColumns particles;
+    particles.reserve(kRows);
+    for (size_t i = 0; i < kRows; ++i) particles.emplaceBack(double(i), 0.0, 0.0, 0.0, 0.0, 0.0, float(i & 7), 0u);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        auto mass = particles.column<6>();
+        double total = 0;
+        for (float m : mass) total += m;
+        gooseBench::doNotOptimize(total);
+    }
+}
+
+GOOSE_BENCH("soaVector/pushBack/goose_soaVector") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        particleColumns particles;
+        for (size_t row = 0; row < 1024; ++row) particles.emplaceBack(double(row), 0.0, 0.0, 0.0, 0.0, 0.0, 1.0f, 0u);
+        gooseBench::doNotOptimize(particles);
+    }
+}
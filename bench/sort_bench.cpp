@@ -0,0 +1,108 @@
+#include "bench.hpp"
+
+#include <gooselib/sort.hpp>
+#include <gooselib/vector.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    constexpr size_t kKeys = 1 << 16;
+
+    uint64_t nextRandom(uint64_t& state) {
+        state += 0x9E3779B97F4A7C15ull;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    template<typename T>
+    const goose::vector<T>& randomKeys() {
+        static goose::vector<T> keys = [] {
+            goose::vector<T> result(kKeys);
+            uint64_t state = 1;
+            for (auto& key : result) key = static_cast<T>(nextRandom(state));
+            return result;
+        }();
+        return keys;
+    }
+
+    struct record {
+        uint32_t key;
+        uint32_t payload[3];
+    };
+
+    const goose::vector<record>& randomRecords() {
+        static goose::vector<record> records = [] {
+            goose::vector<record> result(kKeys);
+            uint64_t state = 2;
+            for (size_t i = 0; i < kKeys; ++i) result[i] = {static_cast<uint32_t>(nextRandom(state)), {uint32_t(i), 0, 0}};
+            return result;
+        }();
+        return records;
+    }
+
+    // Each iteration restores the unsorted input, so every case pays the same copy.
+    template<typename T, typename Sort>
+    void sortCopies(const goose::vector<T>& input, size_t iterations, Sort sort) {
+        goose::vector<T> work(input.size());
+        for (size_t i = 0; i < iterations; ++i) {
+            std::memcpy(work.data(), input.data(), input.size() * sizeof(T));
+            sort(work.data(), work.data() + work.size());
+            gooseBench::clobberMemory();
+        }
+        gooseBench::doNotOptimize(work[0]);
+    }
+
+    bool byKey(const record& a, const record& b) { return a.key < b.key; }
+}
+
+GOOSE_BENCH("sort/uint32/goose_sort") {
+    sortCopies(randomKeys<uint32_t>(), state.iterations, [](uint32_t* first, uint32_t* last) { goose::sort(first, last); });
+}
+
+GOOSE_BENCH("sort/uint32/goose_sort_pdq") {
+    // A comparator other than less keeps sort on the comparison path.
+    sortCopies(randomKeys<uint32_t>(), state.iterations, [](uint32_t* first, uint32_t* last) {
+        goose::sort(first, last, [](uint32_t a, uint32_t b) { return a < b; });
+    });
+}
+
+GOOSE_BENCH("sort/uint32/std_sort") {
+    sortCopies(randomKeys<uint32_t>(), state.iterations, [](uint32_t* first, uint32_t* last) { std::sort(first, last); });
+}
+
+GOOSE_BENCH("sort/uint64/goose_sort") {
+    sortCopies(randomKeys<uint64_t>(), state.iterations, [](uint64_t* first, uint64_t* last) { goose::sort(first, last); });
+}
+
+GOOSE_BENCH("sort/uint64/goose_radixSort") {
+    sortCopies(randomKeys<uint64_t>(), state.iterations, [](uint64_t* first, uint64_t* last) { goose::radixSort(first, last); });
+}
+
+GOOSE_BENCH("sort/uint64/std_sort") {
+    sortCopies(randomKeys<uint64_t>(), state.iterations, [](uint64_t* first, uint64_t* last) { std::sort(first, last); });
+}
+
+GOOSE_BENCH("sort/records/goose_radixSort") {
+    sortCopies(randomRecords(), state.iterations, [](record* first, record* last) {
+        goose::radixSort(first, last, [](const record& r) { return r.key; });
+    });
+}
+
+GOOSE_BENCH("sort/records/goose_sort") {
+    sortCopies(randomRecords(), state.iterations, [](record* first, record* last) { goose::sort(first, last, byKey); });
+}
+
+GOOSE_BENCH("sort/records/std_sort") {
+    sortCopies(randomRecords(), state.iterations, [](record* first, record* last) { std::sort(first, last, byKey); });
+}
+
+GOOSE_BENCH("sort/records/goose_stableSort") {
+    sortCopies(randomRecords(), state.iterations, [](record* first, record* last) { goose::stableSort(first, last, byKey); });
+}
+
+GOOSE_BENCH("sort/records/std_stable_sort") {
+    sortCopies(randomRecords(), state.iterations, [](record* first, record* last) { std::stable_sort(first, last, byKey); });
+}
@@ -0,0 +1,102 @@
+#include "bench.hpp"
+
+#include <gooselib/string.hpp>
+#include <string>
+#include <string_view>
+
+namespace {
+    // A request head like the ones our parsers tokenize: many short fields, CRLF line ends.
+    const std::string& requestHead() {
+        static const std::string head = [] {
+            std::string text = "GET /api/v2/items?limit=50&cursor=abc123 HTTP/1.1\r\n";
+            for (int i = 0; i < 24; ++i) {
+                text += "X-Custom-Header-" + std::to_string(i) + ": value-" + std::to_string(i * 7919)
+                        + ", token;q=0.8, other-token\r\n";
+            }
+            text += "Accept-Encoding: gzip, deflate, br\r\nConnection: keep-alive\r\n\r\n";
+            return text;
+        }();
+        return head;
+    }
+
+    // Header-sized names: longer than libstdc++'s 15-char inline buffer, within goose::string's 23.
+    constexpr const char* kNames[] = {"content-type-options", "x-request-identifier", "accept-encoding-list",
+                                      "strict-transport-sec", "x-forwarded-protocol", "access-control-allow"};
+}
+
+GOOSE_BENCH("string/copyShortToken/goose_string") {
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::string name(kNames[i % 6]);
+        gooseBench::doNotOptimize(name);
+        sum += name.size();
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("string/copyShortToken/std_string") {
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::string name(kNames[i % 6]);
+        gooseBench::doNotOptimize(name);
+        sum += name.size();
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("string/findHeadEnd/goose_stringView") {
+    goose::stringView head(requestHead());
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        sum += head.find("\r\n\r\n");
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("string/findHeadEnd/std_string_view") {
+    std::string_view head(requestHead());
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        sum += head.find("\r\n\r\n");
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+// Splits the head into lines, each line at ':' and the value into comma/semicolon separated tokens.
+GOOSE_BENCH("string/tokenizeHead/goose_stringView") {
+    goose::stringView head(requestHead());
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        for (goose::stringView line : head.split('\n')) {
+            size_t colon = line.find(':');
+            if (colon == goose::stringView::npos) continue;
+            for (goose::stringView token : line.substr(colon + 1).splitAny(",;\r")) sum += token.size();
+        }
+    }
+    gooseBench::doNotOptimize(sum);
+}
+
+GOOSE_BENCH("string/tokenizeHead/std_string_view") {
+    std::string_view head(requestHead());
+    size_t sum = 0;
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        for (size_t start = 0; start <= head.size();) {
+            size_t end = head.find('\n', start);
+            std::string_view line = head.substr(start, end == std::string_view::npos ? end : end - start);
+            start = end == std::string_view::npos ? head.size() + 1 : end + 1;
+            size_t colon = line.find(':');
+            if (colon == std::string_view::npos) continue;
+            std::string_view value = line.substr(colon + 1);
+            for (size_t from = 0; from <= value.size();) {
+                size_t stop = value.find_first_of(",;\r", from);
+                sum += (stop == std::string_view::npos ? value.size() : stop) - from;
+                from = stop == std::string_view::npos ? value.size() + 1 : stop + 1;
+            }
+        }
+    }
+    gooseBench::doNotOptimize(sum);
+}
@@ -0,0 +1,214 @@
+#include "bench.hpp"
+
+#include <gooselib/vector.hpp>
+#include <gooselib/array.hpp>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr size_t kElements = 1024;
+
+    template<typename Vec>
+    Vec makeFilled(size_t count) {
+        Vec v;
+        for (size_t i = 0; i < count; ++i) v.push_back(static_cast<int>(i));
+        return v;
+    }
+
+    template<>
+    goose::vector<int> makeFilled<goose::vector<int>>(size_t count) {
+        goose::vector<int> v;
+        for (size_t i = 0; i < count; ++i) v.pushBack(static_cast<int>(i));
+        return v;
+    }
+
+    struct record {
+        uint64_t id;
+        double price;
+        uint32_t quantity;
+        char tag[12];
+    };
+}
+
+GOOSE_BENCH("vector/constructCount/goose") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::vector<int> v(kElements);
+        gooseBench::doNotOptimize(v.data());
+    }
+}
+
+GOOSE_BENCH("vector/constructCount/std") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::vector<int> v(kElements);
+        gooseBench::doNotOptimize(v.data());
+    }
+}
+
+GOOSE_BENCH("vector/pushBack/goose") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::vector<int> v;
+        for (size_t j = 0; j < kElements; ++j) v.pushBack(static_cast<int>(j));
+        gooseBench::doNotOptimize(v.data());
+    }
+}
+
+GOOSE_BENCH("vector/pushBack/std") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::vector<int> v;
+        for (size_t j = 0; j < kElements; ++j) v.push_back(static_cast<int>(j));
+        gooseBench::doNotOptimize(v.data());
+    }
+}
+
+GOOSE_BENCH("vector/copy/goose") {
+    auto source = makeFilled<goose::vector<int>>(kElements);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::vector<int> copy(source);
+        gooseBench::doNotOptimize(copy.data());
+    }
+}
+
+GOOSE_BENCH("vector/copy/std") {
+    auto source = makeFilled<std::vector<int>>(kElements);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::vector<int> copy(source);
+        gooseBench::doNotOptimize(copy.data());
+    }
+}
+
+GOOSE_BENCH("vector/move/goose") {
+    auto a = makeFilled<goose::vector<int>>(kElements);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::vector<int> b(std::move(a));
+        a = std::move(b);
+        gooseBench::doNotOptimize(a.data());
+    }
+}
+
+GOOSE_BENCH("vector/move/std") {
+    auto a = makeFilled<std::vector<int>>(kElements);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::vector<int> b(std::move(a));
+        a = std::move(b);
+        gooseBench::doNotOptimize(a.data());
+    }
+}
+
+GOOSE_BENCH("vector/iterate/goose") {
+    auto v = makeFilled<goose::vector<int>>(kElements);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        long long sum = 0;
+        for (int x : v) sum += x;
+        gooseBench::doNotOptimize(sum);
+    }
+}
+
+GOOSE_BENCH("vector/iterate/std") {
+    auto v = makeFilled<std::vector<int>>(kElements);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        long long sum = 0;
+        for (int x : v) sum += x;
+        gooseBench::doNotOptimize(sum);
+    }
+}
+
+GOOSE_BENCH("array/iterate/goose") {
+    goose::array<int, kElements> a{};
+    for (size_t j = 0; j < kElements; ++j) a[j] = static_cast<int>(j);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        long long sum = 0;
+        for (int x : a) sum += x;
+        gooseBench::doNotOptimize(sum);
+    }
+}
+
+GOOSE_BENCH("array/iterate/std") {
+    std::array<int, kElements> a{};
+    for (size_t j = 0; j < kElements; ++j) a[j] = static_cast<int>(j);
+    for (size_t i = 0; i < state.iterations; ++i) {
+        gooseBench::clobberMemory();
+        long long sum = 0;
+        for (int x : a) sum += x;
+        gooseBench::doNotOptimize(sum);
+    }
+}
+
+// Macro benchmark: build a batch of records incrementally, then make one filtering pass.
+GOOSE_BENCH("macro/ingestRecords/goose") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::vector<record> batch;
+        for (uint64_t j = 0; j < kElements; ++j) batch.pushBack(record{j, j * 0.5, static_cast<uint32_t>(j % 7), {}});
+        double total = 0;
+        for (const record& r : batch) {
+            if (r.quantity > 2) total += r.price * r.quantity;
+        }
+        gooseBench::doNotOptimize(total);
+    }
+}
+
+GOOSE_BENCH("macro/ingestRecords/std") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::vector<record> batch;
+        for (uint64_t j = 0; j < kElements; ++j) batch.push_back(record{j, j * 0.5, static_cast<uint32_t>(j % 7), {}});
+        double total = 0;
+        for (const record& r : batch) {
+            if (r.quantity > 2) total += r.price * r.quantity;
+        }
+        gooseBench::doNotOptimize(total);
+    }
+}
+
+GOOSE_BENCH("macro/stringTokens/goose") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        goose::vector<std::string> tokens;
+        for (size_t j = 0; j < 256; ++j) tokens.emplaceBack(j % 3 ? "short" : "a-considerably-longer-token-value");
+        gooseBench::doNotOptimize(tokens.data());
+    }
+}
+
+GOOSE_BENCH("macro/stringTokens/std") {
+    for (size_t i = 0; i < state.iterations; ++i) {
+        std::vector<std::string> tokens;
+        for (size_t j = 0; j < 256; ++j) tokens.emplace_back(j % 3 ? "short" : "a-considerably-longer-token-value");
+        gooseBench::doNotOptimize(tokens.data());
+    }
+}
+
+namespace {
+    // Short rows whose length is not a multiple of any vector width, as in per-packet or
+    // per-row kernels where the scalar tail is a large share of the work.
+    constexpr size_t kRowLength = 45;
+    constexpr size_t kRows = 64;
+    constexpr size_t kFloatsPerBlock = 64 / sizeof(float);
+
+    void saxpyTail(const float* __restrict x, float* __restrict y, size_t n) {
+        for (size_t j = 0; j < n; ++j) y[j] += 0.5f * x[j];
+    }
+
+    // Runs in whole blocks past n, which is only valid when the capacity is padded to blocks.
+    void saxpyBlocks(const float* __restrict x, float* __restrict y, size_t n) {
+        for (size_t j = 0; j < n; j += kFloatsPerBlock) {
+            for (size_t k = 0; k < kFloatsPerBlock; ++k) y[j + k] += 0.5f * x[j + k];
+        }
+    }
+}
+
+GOOSE_BENCH("vector/saxpyShortRows/goose_tailLoop") {
+    goose::vector<goose::vector<float>> xs(kRows, goose::vector<float>(kRowLength, 1.0f));
+    goose::vector<goose::vector<float>> ys(kRows, goose::vector<float>(kRowLength, 2.0f));
+    for (size_t i = 0; i < state.iterations; ++i) {
+        for (size_t row = 0; row < kRows; ++row) saxpyTail(xs[row].data(), ys[row].data(), xs[row].size());
+        gooseBench::clobberMemory();
+    }
+}
+
+GOOSE_BENCH("vector/saxpyShortRows/goose_simdVectorPadded") {
+    goose::vector<goose::simdVector<float>> xs(kRows, goose::simdVector<float>(kRowLength, 1.0f));
+    goose::vector<goose::simdVector<float>> ys(kRows, goose::simdVector<float>(kRowLength, 2.0f));
+    for (size_t i = 0; i < state.iterations; ++i) {
+        for (size_t row = 0; row < kRows; ++row) saxpyBlocks(xs[row].data(), ys[row].data(), xs[row].size());
+        gooseBench::clobberMemory();
+    }
+}
@@ -1,15 +1,449 @@
 #pragma once
 
 #include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "iterator.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace goose {
+    namespace _implementation {
+        // Pointers and genericIterators walk contiguous memory, so the kernels below can work on
+        // the raw addresses. Anything else takes the generic loop. elementType is void for those,
+        // so traits over _contiguousValue stay well-formed in conditions that also test value.
+        template<typename It>
+        struct _contiguous : falseType { using elementType = void; };
+
+        template<typename T>
+        struct _contiguous<T*> : trueType { using elementType = T; };
+
+        template<typename T, typename Container>
+        struct _contiguous<genericIterator<T, Container>> : trueType { using elementType = T; };
+
+        template<typename T>
+        T* toPointer(T* it) noexcept { return it; }
+
+        template<typename T, typename Container>
+        T* toPointer(genericIterator<T, Container> it) noexcept { return it.ptr(); }
+
+        template<typename It>
+        using _contiguousValue = removeCV<typename _contiguous<It>::elementType>;
+
+        // Types whose equality is exactly equality of their object representation.
+        template<typename T>
+        inline constexpr bool _bitwiseComparable = (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+                                                   || std::is_pointer_v<T> || std::is_enum_v<T>;
+
+        template<typename It1, typename It2>
+        inline constexpr bool _bitwisePair = [] {
+            if constexpr (_contiguous<It1>::value && _contiguous<It2>::value) {
+                using T1 = _contiguousValue<It1>;
+                using T2 = _contiguousValue<It2>;
+                return std::is_same_v<T1, T2> && _bitwiseComparable<T1>;
+            } else {
+                return false;
+            }
+        }();
+
+        template<typename It, typename V>
+        inline constexpr bool _bitwiseSearch = [] {
+            if constexpr (_contiguous<It>::value) {
+                using T = _contiguousValue<It>;
+                return _bitwiseComparable<T> && std::is_integral_v<T> && std::is_integral_v<V>;
+            } else {
+                return false;
+            }
+        }();
+
+        // Lets constexpr code pick a faster path that constant evaluation cannot take.
+        constexpr bool _isConstantEvaluated() noexcept { return __builtin_is_constant_evaluated(); }
+
+        // True when value converts to U without changing its numeric value.
+        template<typename U, typename V>
+        bool _representable(V value) noexcept {
+            U converted = static_cast<U>(value);
+            if (static_cast<V>(converted) != value) return false;
+            if constexpr (std::is_signed_v<U> == std::is_signed_v<V>) return true;
+            else if constexpr (std::is_signed_v<V>) return value >= 0;
+            else return converted >= 0;
+        }
+
+        namespace simd {
+#if defined(__AVX2__)
+            using reg = __m256i;
+            inline constexpr size_t width = 32;
+            inline reg load(const void* p) noexcept { return _mm256_loadu_si256(static_cast<const reg*>(p)); }
+            inline uint32_t byteMask(reg r) noexcept { return static_cast<uint32_t>(_mm256_movemask_epi8(r)); }
+            inline reg bitAnd(reg a, reg b) noexcept { return _mm256_and_si256(a, b); }
+            inline reg bitOr(reg a, reg b) noexcept { return _mm256_or_si256(a, b); }
+
+            template<size_t K>
+            inline reg cmpeq(reg a, reg b) noexcept {
+                if constexpr (K == 1) return _mm256_cmpeq_epi8(a, b);
+                else if constexpr (K == 2) return _mm256_cmpeq_epi16(a, b);
+                else if constexpr (K == 4) return _mm256_cmpeq_epi32(a, b);
+                else return _mm256_cmpeq_epi64(a, b);
+            }
+
+            template<typename T>
+            inline reg broadcast(T value) noexcept {
+                if constexpr (sizeof(T) == 1) return _mm256_set1_epi8(static_cast<char>(value));
+                else if constexpr (sizeof(T) == 2) return _mm256_set1_epi16(static_cast<short>(value));
+                else if constexpr (sizeof(T) == 4) return _mm256_set1_epi32(static_cast<int>(value));
+                else return _mm256_set1_epi64x(static_cast<long long>(value));
+            }
+#elif defined(__SSE2__)
+            using reg = __m128i;
+            inline constexpr size_t width = 16;
+            inline reg load(const void* p) noexcept { return _mm_loadu_si128(static_cast<const reg*>(p)); }
+            inline uint32_t byteMask(reg r) noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(r)); }
+            inline reg bitAnd(reg a, reg b) noexcept { return _mm_and_si128(a, b); }
+            inline reg bitOr(reg a, reg b) noexcept { return _mm_or_si128(a, b); }
+
+            template<size_t K>
+            inline reg cmpeq(reg a, reg b) noexcept {
+                if constexpr (K == 1) return _mm_cmpeq_epi8(a, b);
+                else if constexpr (K == 2) return _mm_cmpeq_epi16(a, b);
+                else if constexpr (K == 4) return _mm_cmpeq_epi32(a, b);
+                else {
+                    // SSE2 has no 64-bit compare: a lane is equal when both of its 32-bit halves are.
+                    reg halves = _mm_cmpeq_epi32(a, b);
+                    return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+                }
+            }
+
+            template<typename T>
+            inline reg broadcast(T value) noexcept {
+                if constexpr (sizeof(T) == 1) return _mm_set1_epi8(static_cast<char>(value));
+                else if constexpr (sizeof(T) == 2) return _mm_set1_epi16(static_cast<short>(value));
+                else if constexpr (sizeof(T) == 4) return _mm_set1_epi32(static_cast<int>(value));
+                else return _mm_set1_epi64x(static_cast<long long>(value));
+            }
+#endif
+
+            template<typename T>
+            const T* find(const T* first, const T* last, T value) noexcept {
+                if constexpr (sizeof(T) == 1) {
+                    if (first == last) return last;
+                    const void* hit = std::memchr(first, static_cast<unsigned char>(value), last - first);
+                    return hit ? static_cast<const T*>(hit) : last;
+                } else {
+#if defined(__SSE2__)
+                    constexpr size_t lanes = width / sizeof(T);
+                    reg needle = broadcast(value);
+                    for (; static_cast<size_t>(last - first) >= lanes; first += lanes) {
+                        uint32_t mask = byteMask(cmpeq<sizeof(T)>(load(first), needle));
+                        if (mask) return first + __builtin_ctz(mask) / sizeof(T);
+                    }
+#endif
+                    for (; first != last; ++first) {
+                        if (*first == value) return first;
+                    }
+                    return last;
+                }
+            }
+
+            template<typename T>
+            size_t count(const T* first, const T* last, T value) noexcept {
+                size_t result = 0;
+#if defined(__SSE2__)
+                constexpr size_t lanes = width / sizeof(T);
+                reg needle = broadcast(value);
+                size_t matchedBytes = 0;
+                for (; static_cast<size_t>(last - first) >= lanes; first += lanes) {
+                    matchedBytes += __builtin_popcount(byteMask(cmpeq<sizeof(T)>(load(first), needle)));
+                }
+                result = matchedBytes / sizeof(T);
+#endif
+                for (; first != last; ++first) result += (*first == value);
+                return result;
+            }
+
+            // Returns the offset of the first element where the ranges differ, or the length if none do.
+            template<typename T>
+            size_t mismatch(const T* first1, const T* first2, size_t length) noexcept {
+                size_t index = 0;
+#if defined(__SSE2__)
+                constexpr size_t lanes = width / sizeof(T);
+                for (; length - index >= lanes; index += lanes) {
+                    uint32_t mask = ~byteMask(cmpeq<1>(load(first1 + index), load(first2 + index)));
+                    if constexpr (width == 16) mask &= 0xFFFFu;
+                    if (mask) return index + __builtin_ctz(mask) / sizeof(T);
+                }
+#endif
+                for (; index != length; ++index) {
+                    if (first1[index] != first2[index]) return index;
+                }
+                return length;
+            }
+        }
+    }
+
+    template<class It1, class It2>
+    std::pair<It1, It2> mismatch(It1 first1, It1 last1, It2 first2) {
+        if constexpr (_implementation::_bitwisePair<It1, It2>) {
+            size_t length = last1 - first1;
+            size_t offset = _implementation::simd::mismatch(_implementation::toPointer(first1),
+                                                            _implementation::toPointer(first2), length);
+            return {first1 + offset, first2 + offset};
+        } else {
+            for (; first1 != last1 && *first1 == *first2; ++first1, (void) ++first2) { }
+            return {first1, first2};
+        }
+    }
+
+    template<class It1, class It2>
+    std::pair<It1, It2> mismatch(It1 first1, It1 last1, It2 first2, It2 last2) {
+        if constexpr (_implementation::_bitwisePair<It1, It2>) {
+            size_t length1 = last1 - first1;
+            size_t length2 = last2 - first2;
+            return goose::mismatch(first1, first1 + (length1 < length2 ? length1 : length2), first2);
+        } else {
+            for (; first1 != last1 && first2 != last2 && *first1 == *first2; ++first1, (void) ++first2) { }
+            return {first1, first2};
+        }
+    }
+
+    template<class It1, class It2>
+    bool equal(It1 first1, It1 last1, It2 first2) {
+        if constexpr (_implementation::_bitwisePair<It1, It2>) {
+            size_t length = last1 - first1;
+            return length == 0 || std::memcmp(_implementation::toPointer(first1), _implementation::toPointer(first2),
+                                              length * sizeof(*_implementation::toPointer(first1))) == 0;
+        } else {
+            for (; first1 != last1; ++first1, (void) ++first2) {
+                if (!(*first1 == *first2)) return false;
+            }
+            return true;
+        }
+    }
+
+    template<class It1, class It2>
+    bool equal(It1 first1, It1 last1, It2 first2, It2 last2) {
+        if constexpr (_implementation::_contiguous<It1>::value && _implementation::_contiguous<It2>::value) {
+            if (last1 - first1 != last2 - first2) return false;
+            return goose::equal(first1, last1, first2);
+        } else {
+            for (; first1 != last1 && first2 != last2; ++first1, (void) ++first2) {
+                if (!(*first1 == *first2)) return false;
+            }
+            return first1 == last1 && first2 == last2;
+        }
+    }
+
+    template<class It, class T>
+    It find(It first, It last, const T& value) {
+        if constexpr (_implementation::_bitwiseSearch<It, T>) {
+            using U = _implementation::_contiguousValue<It>;
+            // A needle that does not survive the conversion can never compare equal.
+            if (!_implementation::_representable<U>(value)) return last;
+            U needle = static_cast<U>(value);
+            const U* base = _implementation::toPointer(first);
+            return first + (_implementation::simd::find<U>(base, base + (last - first), needle) - base);
+        } else {
+            for (; first != last; ++first) {
+                if (*first == value) return first;
+            }
+            return last;
+        }
+    }
+
+    template<class It, class T>
+    std::ptrdiff_t count(It first, It last, const T& value) {
+        if constexpr (_implementation::_bitwiseSearch<It, T>) {
+            using U = _implementation::_contiguousValue<It>;
+            if (!_implementation::_representable<U>(value)) return 0;
+            U needle = static_cast<U>(value);
+            const U* base = _implementation::toPointer(first);
+            return _implementation::simd::count<U>(base, base + (last - first), needle);
+        } else {
+            std::ptrdiff_t result = 0;
+            for (; first != last; ++first) {
+                if (*first == value) ++result;
+            }
+            return result;
+        }
+    }
+
+    // Returns the first smallest and the last largest element, or {last, last} for an empty range.
+    template<class It>
+    std::pair<It, It> minMax(It first, It last) {
+        if (first == last) return {last, last};
+        if constexpr (_implementation::_contiguous<It>::value
+                      && std::is_arithmetic_v<_implementation::_contiguousValue<It>>
+                      && !std::is_floating_point_v<_implementation::_contiguousValue<It>>) {
+            // Reduce to the two values with a branch-free loop the compiler turns into packed
+            // min/max, then locate them with the vectorized find.
+            using T = _implementation::_contiguousValue<It>;
+            const T* base = _implementation::toPointer(first);
+            size_t length = last - first;
+            T lo = base[0];
+            T hi = base[0];
+            for (size_t i = 1; i < length; ++i) {
+                lo = base[i] < lo ? base[i] : lo;
+                hi = base[i] > hi ? base[i] : hi;
+            }
+            It minIt = goose::find(first, last, lo);
+            size_t maxIndex = length - 1;
+            while (base[maxIndex] != hi) --maxIndex;
+            return {minIt, first + maxIndex};
+        } else {
+            It lo = first;
+            It hi = first;
+            for (++first; first != last; ++first) {
+                if (*first < *lo) lo = first;
+                if (!(*first < *hi)) hi = first;
+            }
+            return {lo, hi};
+        }
+    }
+
+    template<class It, class T, class BinaryOp>
+    T accumulate(It first, It last, T init, BinaryOp op) {
+        for (; first != last; ++first) {
+            init = op(std::move(init), *first);
+        }
+        return init;
+    }
+
+    template<class It, class T>
+    T accumulate(It first, It last, T init) {
+        if constexpr (_implementation::_contiguous<It>::value && std::is_integral_v<T>
+                      && std::is_integral_v<_implementation::_contiguousValue<It>>) {
+            // Integer addition is associative, so independent partial sums give the same result
+            // while breaking the dependency chain for the vectorizer.
+            using U = _implementation::_contiguousValue<It>;
+            const U* p = _implementation::toPointer(first);
+            size_t length = last - first;
+            T sums[4] = {init, T{}, T{}, T{}};
+            size_t i = 0;
+            for (; i + 4 <= length; i += 4) {
+                sums[0] += p[i];
+                sums[1] += p[i + 1];
+                sums[2] += p[i + 2];
+                sums[3] += p[i + 3];
+            }
+            for (; i < length; ++i) sums[0] += p[i];
+            return sums[0] + sums[1] + sums[2] + sums[3];
+        } else {
+            for (; first != last; ++first) {
+                init = std::move(init) + *first;
+            }
+            return init;
+        }
+    }
+
+    template<class It, class F>
+    F forEach(It first, It last, F f) {
+        for (; first != last; ++first) f(*first);
+        return f;
+    }
+
+    template<class It, class OutIt, class UnaryOp>
+    OutIt transform(It first, It last, OutIt out, UnaryOp op) {
+        for (; first != last; ++first, (void) ++out) *out = op(*first);
+        return out;
+    }
+
+    template<class It, class T, class BinaryOp>
+    T reduce(It first, It last, T init, BinaryOp op) {
+        return goose::accumulate(first, last, std::move(init), op);
+    }
+
+    template<class It, class T>
+    T reduce(It first, It last, T init) {
+        return goose::accumulate(first, last, std::move(init));
+    }
+
+    template<class It, class T, class ReduceOp, class TransformOp>
+    T transformReduce(It first, It last, T init, ReduceOp reduceOp, TransformOp transformOp) {
+        for (; first != last; ++first) {
+            init = reduceOp(std::move(init), transformOp(*first));
+        }
+        return init;
+    }
+
+    template<class It, class OutIt, class BinaryOp>
+    OutIt inclusiveScan(It first, It last, OutIt out, BinaryOp op) {
+        if (first == last) return out;
+        auto running = *first;
+        *out = running;
+        for (++first, ++out; first != last; ++first, (void) ++out) {
+            running = op(std::move(running), *first);
+            *out = running;
+        }
+        return out;
+    }
+
+    template<class It, class OutIt>
+    OutIt inclusiveScan(It first, It last, OutIt out) {
+        return goose::inclusiveScan(first, last, out, [](const auto& a, const auto& b) { return a + b; });
+    }
+
     template<class It1, class It2>
     bool lexicographicalCompare(It1 first1, It1 last1,
                                  It2 first2, It2 last2) {
-        for ( ; (first1 != last1) && (first2 != last2); ++first1, (void) ++first2 ) {
-            if (*first1 < *first2) return true;
-            if (*first2 < *first1) return false;
+        if constexpr (_implementation::_bitwisePair<It1, It2>
+                      && std::is_integral_v<_implementation::_contiguousValue<It1>>) {
+            using T = _implementation::_contiguousValue<It1>;
+            size_t length1 = last1 - first1;
+            size_t length2 = last2 - first2;
+            size_t common = length1 < length2 ? length1 : length2;
+            if constexpr (sizeof(T) == 1 && std::is_unsigned_v<T>) {
+                // memcmp orders bytes as unsigned char, which matches T exactly.
+                int order = common ? std::memcmp(_implementation::toPointer(first1), _implementation::toPointer(first2), common) : 0;
+                if (order != 0) return order < 0;
+            } else {
+                size_t offset = _implementation::simd::mismatch(_implementation::toPointer(first1),
+                                                                _implementation::toPointer(first2), common);
+                if (offset != common) return _implementation::toPointer(first1)[offset] < _implementation::toPointer(first2)[offset];
+            }
+            return length1 < length2;
+        } else {
+            for ( ; (first1 != last1) && (first2 != last2); ++first1, (void) ++first2 ) {
+                if (*first1 < *first2) return true;
+                if (*first2 < *first1) return false;
+            }
+            return (first1 == last1) && (first2 != last2);
         }
-        return (first1 == last1) && (first2 != last2);
     }
-}
\ No newline at end of file
+
+    // First position whose element is not ordered before value.
+    template<class It, class T, class Compare>
+    constexpr It lowerBound(It first, It last, const T& value, Compare comp) {
+        auto length = goose::distance(first, last);
+        while (length > 0) {
+            auto half = length / 2;
+            It mid = first;
+            mid += half;
+            if (comp(*mid, value)) {
+                first = ++mid;
+                length -= half + 1;
+            } else {
+                length = half;
+            }
+        }
+        return first;
+    }
+
+    template<class It, class T>
+    constexpr It lowerBound(It first, It last, const T& value) {
+        return goose::lowerBound(first, last, value, [](const auto& a, const auto& b) { return a < b; });
+    }
+
+    template<class It, class T, class Compare>
+    constexpr bool binarySearch(It first, It last, const T& value, Compare comp) {
+        first = goose::lowerBound(first, last, value, comp);
+        return first != last && !comp(value, *first);
+    }
+
+    template<class It, class T>
+    constexpr bool binarySearch(It first, It last, const T& value) {
+        return goose::binarySearch(first, last, value, [](const auto& a, const auto& b) { return a < b; });
+    }
+}
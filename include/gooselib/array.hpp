@@ -27,8 +27,8 @@ namespace goose {
             constexpr reference front() noexcept { return _mElems[0]; }
             constexpr constReference front() const noexcept { return _mElems[0]; }
         
-            constexpr reference back() noexcept { return _mElems[this->size()]; }
-            constexpr constReference back() const noexcept { return _mElems[this->size()]; }
+            constexpr reference back() noexcept { return _mElems[N - 1]; }
+            constexpr constReference back() const noexcept { return _mElems[N - 1]; }
         
             constexpr pointer data(size_t pos) noexcept { return _mElems; }
             constexpr constPointer data(size_t pos) const noexcept { return _mElems; }
@@ -67,10 +67,7 @@ namespace goose {
 
         public:
             bool operator==(const array &other) const {
-                for (sizeType i = 0; i < this->size(); ++i) {
-                    if((*this)[i] != other[i]) return false;
-                }
-                return true;
+                return goose::equal(this->begin(), this->end(), other.begin());
             }
         
             bool operator!=(const array &other) const {
@@ -0,0 +1,515 @@
+#pragma once
+
+#include "memory.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace goose {
+    namespace _implementation {
+        inline constexpr size_t _wordBits = 64;
+
+        constexpr size_t _wordsFor(size_t bits) noexcept { return (bits + _wordBits - 1) / _wordBits; }
+
+        // Mask of the bits of the last word that lie inside a bitset of size bits.
+        constexpr uint64_t _tailMask(size_t bits) noexcept {
+            return bits % _wordBits ? (uint64_t{1} << (bits % _wordBits)) - 1 : ~uint64_t{0};
+        }
+
+        // One POPCNT instruction when the target has it (-mpopcnt, -march=x86-64-v2 and up, every
+        // aarch64). Baseline x86-64 would get a libgcc call instead, which the bit trick beats.
+        constexpr int _popcount(uint64_t word) noexcept {
+#if defined(__x86_64__) && !defined(__POPCNT__)
+            word = word - ((word >> 1) & 0x5555555555555555ull);
+            word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+            word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+            return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+#else
+            return __builtin_popcountll(word);
+#endif
+        }
+
+        // Position of the k-th set bit of word, counting from zero; word has more than k set bits.
+        inline unsigned _selectInWord(uint64_t word, unsigned k) noexcept {
+#if defined(__BMI2__)
+            return static_cast<unsigned>(__builtin_ctzll(_pdep_u64(uint64_t{1} << k, word)));
+#else
+            // Byte counts summed into running totals pick the byte; a short loop finishes inside it.
+            uint64_t counts = word - ((word >> 1) & 0x5555555555555555ull);
+            counts = (counts & 0x3333333333333333ull) + ((counts >> 2) & 0x3333333333333333ull);
+            counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+            uint64_t prefix = counts * 0x0101010101010101ull;
+            unsigned byte = 0;
+            while (((prefix >> (8 * byte)) & 0xFF) <= k) ++byte;
+            if (byte > 0) k -= static_cast<unsigned>((prefix >> (8 * (byte - 1))) & 0xFF);
+            uint64_t bits = (word >> (8 * byte)) & 0xFF;
+            for (; k > 0; --k) bits &= bits - 1;
+            return 8 * byte + static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+        }
+
+        enum class _bitOp { andOp, orOp, xorOp, andNotOp };
+
+        template<_bitOp Op>
+        constexpr uint64_t _combine(uint64_t a, uint64_t b) noexcept {
+            if constexpr (Op == _bitOp::andOp) return a & b;
+            else if constexpr (Op == _bitOp::orOp) return a | b;
+            else if constexpr (Op == _bitOp::xorOp) return a ^ b;
+            else return a & ~b;
+        }
+
+        // dst = dst op src over count words, a vector register at a time where there is one.
+        template<_bitOp Op>
+        void _combineWords(uint64_t* dst, const uint64_t* src, size_t count) noexcept {
+            size_t i = 0;
+#if defined(__AVX2__)
+            for (; i + 4 <= count; i += 4) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                __m256i r;
+                if constexpr (Op == _bitOp::andOp) r = _mm256_and_si256(a, b);
+                else if constexpr (Op == _bitOp::orOp) r = _mm256_or_si256(a, b);
+                else if constexpr (Op == _bitOp::xorOp) r = _mm256_xor_si256(a, b);
+                else r = _mm256_andnot_si256(b, a);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+            }
+#elif defined(__SSE2__)
+            for (; i + 2 <= count; i += 2) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i r;
+                if constexpr (Op == _bitOp::andOp) r = _mm_and_si128(a, b);
+                else if constexpr (Op == _bitOp::orOp) r = _mm_or_si128(a, b);
+                else if constexpr (Op == _bitOp::xorOp) r = _mm_xor_si128(a, b);
+                else r = _mm_andnot_si128(b, a);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+            }
+#endif
+            for (; i < count; ++i) dst[i] = _combine<Op>(dst[i], src[i]);
+        }
+
+        constexpr size_t _countWords(const uint64_t* words, size_t count) noexcept {
+            size_t total = 0;
+            for (size_t i = 0; i < count; ++i) total += static_cast<size_t>(_popcount(words[i]));
+            return total;
+        }
+
+        // First set bit at or after from, or bits when there is none. Bits past the end are zero.
+        constexpr size_t _findFrom(const uint64_t* words, size_t bits, size_t from) noexcept {
+            if (from >= bits) return bits;
+            size_t index = from / _wordBits;
+            uint64_t word = words[index] & (~uint64_t{0} << (from % _wordBits));
+            size_t count = _wordsFor(bits);
+            while (true) {
+                if (word) return index * _wordBits + static_cast<size_t>(__builtin_ctzll(word));
+                if (++index == count) return bits;
+                word = words[index];
+            }
+        }
+
+        // Proxy returned by the non-const operator[] of the bitsets.
+        struct _bitReference {
+            public:
+                constexpr _bitReference(uint64_t& word, uint64_t mask) noexcept : mWord{&word}, mMask{mask} {}
+                constexpr _bitReference(const _bitReference&) noexcept = default;
+
+                constexpr operator bool() const noexcept { return (*mWord & mMask) != 0; }
+
+                constexpr _bitReference& operator=(bool value) noexcept {
+                    if (value) *mWord |= mMask;
+                    else *mWord &= ~mMask;
+                    return *this;
+                }
+
+                constexpr _bitReference& operator=(const _bitReference& other) noexcept { return *this = bool(other); }
+
+                constexpr void flip() noexcept { *mWord ^= mMask; }
+            private:
+                uint64_t* mWord;
+                uint64_t mMask;
+        };
+    }
+
+    // Fixed-size bitset of N bits packed into 64-bit words, the bit counterpart of goose::array.
+    // Bits beyond N in the last word are kept zero, so counting and searching never mask.
+    template<size_t N>
+    struct bitArray {
+        public:
+            using sizeType = size_t;
+            using reference = _implementation::_bitReference;
+
+            static constexpr sizeType wordCount = N ? _implementation::_wordsFor(N) : 1;
+        public:
+            constexpr bool operator[](sizeType pos) const noexcept { return test(pos); }
+            constexpr reference operator[](sizeType pos) noexcept { return {mWords[pos / 64], uint64_t{1} << (pos % 64)}; }
+
+            constexpr bool test(sizeType pos) const noexcept { return (mWords[pos / 64] >> (pos % 64)) & 1; }
+            constexpr void set(sizeType pos) noexcept { mWords[pos / 64] |= uint64_t{1} << (pos % 64); }
+            constexpr void set(sizeType pos, bool value) noexcept { (*this)[pos] = value; }
+            constexpr void reset(sizeType pos) noexcept { mWords[pos / 64] &= ~(uint64_t{1} << (pos % 64)); }
+            constexpr void flip(sizeType pos) noexcept { mWords[pos / 64] ^= uint64_t{1} << (pos % 64); }
+
+            constexpr void set() noexcept {
+                for (sizeType i = 0; i < wordCount; ++i) mWords[i] = ~uint64_t{0};
+                clearTail();
+            }
+            constexpr void reset() noexcept {
+                for (sizeType i = 0; i < wordCount; ++i) mWords[i] = 0;
+            }
+            constexpr void flip() noexcept {
+                for (sizeType i = 0; i < wordCount; ++i) mWords[i] = ~mWords[i];
+                clearTail();
+            }
+        public:
+            constexpr sizeType size() const noexcept { return N; }
+            constexpr sizeType count() const noexcept { return _implementation::_countWords(mWords, wordCount); }
+            constexpr bool any() const noexcept {
+                for (sizeType i = 0; i < wordCount; ++i) {
+                    if (mWords[i]) return true;
+                }
+                return false;
+            }
+            constexpr bool none() const noexcept { return !any(); }
+            constexpr bool all() const noexcept { return count() == N; }
+
+            // Index of the first set bit, or size() when none is set.
+            constexpr sizeType findFirst() const noexcept { return _implementation::_findFrom(mWords, N, 0); }
+            // Index of the first set bit after pos, or size().
+            constexpr sizeType findNext(sizeType pos) const noexcept { return _implementation::_findFrom(mWords, N, pos + 1); }
+
+            // Calls f(index) for every set bit in increasing order.
+            template<typename F>
+            constexpr void forEachSet(F f) const {
+                for (sizeType i = 0; i < wordCount; ++i) {
+                    for (uint64_t word = mWords[i]; word; word &= word - 1) f(i * 64 + static_cast<sizeType>(__builtin_ctzll(word)));
+                }
+            }
+
+            constexpr uint64_t* data() noexcept { return mWords; }
+            constexpr const uint64_t* data() const noexcept { return mWords; }
+        public:
+            bitArray& operator&=(const bitArray& other) noexcept { return combine<_implementation::_bitOp::andOp>(other); }
+            bitArray& operator|=(const bitArray& other) noexcept { return combine<_implementation::_bitOp::orOp>(other); }
+            bitArray& operator^=(const bitArray& other) noexcept { return combine<_implementation::_bitOp::xorOp>(other); }
+            // Clears every bit that is set in other.
+            bitArray& andNot(const bitArray& other) noexcept { return combine<_implementation::_bitOp::andNotOp>(other); }
+
+            friend bitArray operator&(bitArray lhs, const bitArray& rhs) noexcept { return lhs &= rhs; }
+            friend bitArray operator|(bitArray lhs, const bitArray& rhs) noexcept { return lhs |= rhs; }
+            friend bitArray operator^(bitArray lhs, const bitArray& rhs) noexcept { return lhs ^= rhs; }
+            constexpr bitArray operator~() const noexcept {
+                bitArray result = *this;
+                result.flip();
+                return result;
+            }
+
+            constexpr bool operator==(const bitArray& other) const noexcept {
+                for (sizeType i = 0; i < wordCount; ++i) {
+                    if (mWords[i] != other.mWords[i]) return false;
+                }
+                return true;
+            }
+            constexpr bool operator!=(const bitArray& other) const noexcept { return !(*this == other); }
+        private:
+            template<_implementation::_bitOp Op>
+            bitArray& combine(const bitArray& other) noexcept {
+                _implementation::_combineWords<Op>(mWords, other.mWords, wordCount);
+                return *this;
+            }
+
+            constexpr void clearTail() noexcept { mWords[wordCount - 1] &= N ? _implementation::_tailMask(N) : 0; }
+
+            uint64_t mWords[wordCount]{};
+    };
+
+    // Resizable bitset whose words come from Alloc. Set operations need both sides to have the
+    // same size. Bits beyond size() in the last word are kept zero.
+    template<typename Alloc = allocator<uint64_t>>
+    struct bitVector {
+        private:
+            using wordAlloc = typename allocatorTraits<Alloc>::template rebindAlloc<uint64_t>;
+            using wordTraits = allocatorTraits<wordAlloc>;
+            static constexpr size_t growthFactor = 2;
+        public:
+            using sizeType = size_t;
+            using allocatorType = Alloc;
+            using reference = _implementation::_bitReference;
+        public:
+            bitVector() = default;
+            explicit bitVector(const Alloc& alloc) : mAlloc(alloc) {}
+
+            explicit bitVector(sizeType bits, bool value = false, const Alloc& alloc = Alloc()) : mAlloc(alloc) {
+                resize(bits, value);
+            }
+
+            bitVector(const bitVector& other) : mAlloc(other.mAlloc) {
+                reserve(other.mSize);
+                copyWords(other);
+            }
+
+            bitVector(bitVector&& other) noexcept
+                : mWords{goose::exchange(other.mWords, nullptr)}, mSize{goose::exchange(other.mSize, 0)},
+                  mCapWords{goose::exchange(other.mCapWords, 0)}, mAlloc{std::move(other.mAlloc)} {}
+
+            ~bitVector() { releaseWords(); }
+
+            bitVector& operator=(const bitVector& other) {
+                if (this == &other) return *this;
+                reserve(other.mSize);
+                copyWords(other);
+                return *this;
+            }
+
+            bitVector& operator=(bitVector&& other) noexcept {
+                if (this == &other) return *this;
+                releaseWords();
+                mWords = goose::exchange(other.mWords, nullptr);
+                mSize = goose::exchange(other.mSize, 0);
+                mCapWords = goose::exchange(other.mCapWords, 0);
+                mAlloc = std::move(other.mAlloc);
+                return *this;
+            }
+        public:
+            bool operator[](sizeType pos) const noexcept { return test(pos); }
+            reference operator[](sizeType pos) noexcept { return {mWords[pos / 64], uint64_t{1} << (pos % 64)}; }
+
+            bool test(sizeType pos) const noexcept { return (mWords[pos / 64] >> (pos % 64)) & 1; }
+            void set(sizeType pos) noexcept { mWords[pos / 64] |= uint64_t{1} << (pos % 64); }
+            void set(sizeType pos, bool value) noexcept { (*this)[pos] = value; }
+            void reset(sizeType pos) noexcept { mWords[pos / 64] &= ~(uint64_t{1} << (pos % 64)); }
+            void flip(sizeType pos) noexcept { mWords[pos / 64] ^= uint64_t{1} << (pos % 64); }
+
+            void set() noexcept {
+                for (sizeType i = 0; i < wordCount(); ++i) mWords[i] = ~uint64_t{0};
+                clearTail();
+            }
+            void reset() noexcept {
+                for (sizeType i = 0; i < wordCount(); ++i) mWords[i] = 0;
+            }
+            void flip() noexcept {
+                for (sizeType i = 0; i < wordCount(); ++i) mWords[i] = ~mWords[i];
+                clearTail();
+            }
+        public:
+            sizeType size() const noexcept { return mSize; }
+            bool empty() const noexcept { return mSize == 0; }
+            sizeType capacity() const noexcept { return mCapWords * 64; }
+            sizeType wordCount() const noexcept { return _implementation::_wordsFor(mSize); }
+
+            sizeType count() const noexcept { return _implementation::_countWords(mWords, wordCount()); }
+            bool any() const noexcept {
+                for (sizeType i = 0; i < wordCount(); ++i) {
+                    if (mWords[i]) return true;
+                }
+                return false;
+            }
+            bool none() const noexcept { return !any(); }
+            bool all() const noexcept { return count() == mSize; }
+
+            sizeType findFirst() const noexcept { return _implementation::_findFrom(mWords, mSize, 0); }
+            sizeType findNext(sizeType pos) const noexcept { return _implementation::_findFrom(mWords, mSize, pos + 1); }
+
+            template<typename F>
+            void forEachSet(F f) const {
+                for (sizeType i = 0; i < wordCount(); ++i) {
+                    for (uint64_t word = mWords[i]; word; word &= word - 1) f(i * 64 + static_cast<sizeType>(__builtin_ctzll(word)));
+                }
+            }
+
+            uint64_t* data() noexcept { return mWords; }
+            const uint64_t* data() const noexcept { return mWords; }
+            allocatorType getAllocator() const noexcept { return mAlloc; }
+        public:
+            void reserve(sizeType bits) {
+                sizeType words = _implementation::_wordsFor(bits);
+                if (words <= mCapWords) return;
+                uint64_t* newWords = wordTraits::allocate(mAlloc, words);
+                for (sizeType i = 0; i < wordCount(); ++i) newWords[i] = mWords[i];
+                releaseWords();
+                mWords = newWords;
+                mCapWords = words;
+            }
+
+            // New bits take value.
+            void resize(sizeType bits, bool value = false) {
+                sizeType oldSize = mSize;
+                if (bits > oldSize) {
+                    reserve(bits);
+                    sizeType oldWords = wordCount();
+                    sizeType newWords = _implementation::_wordsFor(bits);
+                    uint64_t fill = value ? ~uint64_t{0} : 0;
+                    if (oldWords && value) mWords[oldWords - 1] |= ~_implementation::_tailMask(oldSize);
+                    for (sizeType i = oldWords; i < newWords; ++i) mWords[i] = fill;
+                }
+                mSize = bits;
+                clearTail();
+            }
+
+            void pushBack(bool value) {
+                if (mSize == mCapWords * 64) reserve(mCapWords ? mCapWords * 64 * growthFactor : 64);
+                if (mSize % 64 == 0) mWords[mSize / 64] = 0;
+                mWords[mSize / 64] |= uint64_t{value} << (mSize % 64);
+                ++mSize;
+            }
+
+            void popBack() noexcept {
+                --mSize;
+                reset(mSize);
+            }
+
+            void clear() noexcept { mSize = 0; }
+
+            void shrinkToFit() {
+                if (wordCount() == mCapWords) return;
+                bitVector copy(*this);
+                *this = std::move(copy);
+            }
+        public:
+            bitVector& operator&=(const bitVector& other) noexcept { return combine<_implementation::_bitOp::andOp>(other); }
+            bitVector& operator|=(const bitVector& other) noexcept { return combine<_implementation::_bitOp::orOp>(other); }
+            bitVector& operator^=(const bitVector& other) noexcept { return combine<_implementation::_bitOp::xorOp>(other); }
+            bitVector& andNot(const bitVector& other) noexcept { return combine<_implementation::_bitOp::andNotOp>(other); }
+
+            friend bitVector operator&(bitVector lhs, const bitVector& rhs) { return lhs &= rhs; }
+            friend bitVector operator|(bitVector lhs, const bitVector& rhs) { return lhs |= rhs; }
+            friend bitVector operator^(bitVector lhs, const bitVector& rhs) { return lhs ^= rhs; }
+            bitVector operator~() const {
+                bitVector result = *this;
+                result.flip();
+                return result;
+            }
+
+            bool operator==(const bitVector& other) const noexcept {
+                if (mSize != other.mSize) return false;
+                for (sizeType i = 0; i < wordCount(); ++i) {
+                    if (mWords[i] != other.mWords[i]) return false;
+                }
+                return true;
+            }
+            bool operator!=(const bitVector& other) const noexcept { return !(*this == other); }
+        private:
+            template<_implementation::_bitOp Op>
+            bitVector& combine(const bitVector& other) noexcept {
+                _implementation::_combineWords<Op>(mWords, other.mWords, wordCount());
+                return *this;
+            }
+
+            void clearTail() noexcept {
+                if (mSize) mWords[wordCount() - 1] &= _implementation::_tailMask(mSize);
+            }
+
+            void copyWords(const bitVector& other) noexcept {
+                for (sizeType i = 0; i < other.wordCount(); ++i) mWords[i] = other.mWords[i];
+                mSize = other.mSize;
+            }
+
+            void releaseWords() noexcept {
+                if (mWords) wordTraits::deallocate(mAlloc, mWords, mCapWords);
+                mWords = nullptr;
+                mCapWords = 0;
+            }
+        private:
+            uint64_t* mWords{nullptr};
+            sizeType mSize{0};
+            sizeType mCapWords{0};
+            wordAlloc mAlloc;
+    };
+
+    // Rank/select directory over a bitArray or bitVector, in the rank9 layout: per 512-bit block
+    // one absolute count and the seven in-block word counts packed as 9-bit fields, 25% on top of
+    // the bits. rank is then two loads and one popcount; select binary-searches the blocks and
+    // finishes with the packed counts and a select inside one word. The index reads the bitset's
+    // words in place, so the bitset must outlive it and not change while it is in use.
+    struct rankSelectIndex {
+        public:
+            using sizeType = size_t;
+        public:
+            rankSelectIndex() = default;
+
+            template<typename Bits>
+            explicit rankSelectIndex(const Bits& bits) : mWords{bits.data()}, mSize{bits.size()} {
+                sizeType words = _implementation::_wordsFor(mSize);
+                sizeType blocks = (words + 7) / 8;
+                mBlocks.resize(2 * blocks + 1);
+                uint64_t total = 0;
+                for (sizeType b = 0; b < blocks; ++b) {
+                    mBlocks[2 * b] = total;
+                    uint64_t packed = 0;
+                    uint64_t inBlock = 0;
+                    for (sizeType w = 0; w < 8; ++w) {
+                        if (w > 0) packed |= inBlock << (9 * (w - 1));
+                        sizeType index = 8 * b + w;
+                        if (index < words) inBlock += static_cast<uint64_t>(_implementation::_popcount(mWords[index]));
+                    }
+                    mBlocks[2 * b + 1] = packed;
+                    total += inBlock;
+                }
+                mBlocks[2 * blocks] = total;
+            }
+        public:
+            sizeType size() const noexcept { return mSize; }
+            sizeType ones() const noexcept { return static_cast<sizeType>(mBlocks.empty() ? 0 : mBlocks.back()); }
+            sizeType zeros() const noexcept { return mSize - ones(); }
+
+            // Set bits in [0, pos), for pos <= size().
+            sizeType rank1(sizeType pos) const noexcept {
+                if (pos == mSize) return ones();
+                sizeType word = pos / 64;
+                sizeType block = word / 8;
+                sizeType result = static_cast<sizeType>(mBlocks[2 * block] + inBlockRank(block, word % 8));
+                uint64_t below = (uint64_t{1} << (pos % 64)) - 1;
+                return result + static_cast<sizeType>(_implementation::_popcount(mWords[word] & below));
+            }
+
+            sizeType rank0(sizeType pos) const noexcept { return pos - rank1(pos); }
+
+            // Position of the set bit with rank k (the (k+1)-th one), or size() if there are not
+            // that many.
+            sizeType select1(sizeType k) const noexcept { return select<true>(k); }
+            sizeType select0(sizeType k) const noexcept { return select<false>(k); }
+        private:
+            uint64_t inBlockRank(sizeType block, sizeType word) const noexcept {
+                return word == 0 ? 0 : (mBlocks[2 * block + 1] >> (9 * (word - 1))) & 0x1FF;
+            }
+
+            // Counts and words as seen by the select being answered: zeros are counted as the
+            // complement of the ones.
+            template<bool One>
+            uint64_t blockRank(sizeType block) const noexcept {
+                return One ? mBlocks[2 * block] : uint64_t{block} * 512 - mBlocks[2 * block];
+            }
+
+            template<bool One>
+            sizeType select(sizeType k) const noexcept {
+                if (k >= (One ? ones() : zeros())) return mSize;
+                // Last block whose rank is at most k.
+                sizeType lo = 0, hi = (mBlocks.size() - 1) / 2;
+                while (hi - lo > 1) {
+                    sizeType mid = lo + (hi - lo) / 2;
+                    if (blockRank<One>(mid) <= k) lo = mid;
+                    else hi = mid;
+                }
+                uint64_t remaining = k - blockRank<One>(lo);
+                sizeType word = 0;
+                for (sizeType w = 1; w < 8; ++w) {
+                    uint64_t before = One ? inBlockRank(lo, w) : 64 * w - inBlockRank(lo, w);
+                    if (before > remaining) break;
+                    word = w;
+                }
+                remaining -= One ? inBlockRank(lo, word) : 64 * word - inBlockRank(lo, word);
+                sizeType index = 8 * lo + word;
+                uint64_t bits = One ? mWords[index] : ~mWords[index];
+                return index * 64 + _implementation::_selectInWord(bits, static_cast<unsigned>(remaining));
+            }
+        private:
+            const uint64_t* mWords{nullptr};
+            sizeType mSize{0};
+            goose::vector<uint64_t> mBlocks;
+    };
+}
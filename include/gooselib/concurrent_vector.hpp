@@ -0,0 +1,275 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "utility.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace goose {
+    namespace _implementation {
+        constexpr unsigned _bitWidth(size_t n) noexcept {
+            return n == 0 ? 0 : static_cast<unsigned>(sizeof(size_t) * 8 - __builtin_clzll(n));
+        }
+    }
+
+    // Vector that many threads can append to at once. Elements live in segments that double in
+    // size and are never reallocated, so a reference stays valid for the vector's lifetime, even
+    // while other threads keep appending. An append claims its slots with one fetch_add, and the
+    // thread that first needs a segment installs it with a CAS; nothing takes a lock.
+    //
+    // Segments 0 and 1 hold firstSegmentSize elements each and segment k > 1 holds twice as many
+    // as segment k - 1, so element i is in segment bitWidth(i / firstSegmentSize).
+    //
+    // size() counts claimed slots, and while appends are in flight some of those may still be
+    // under construction. An element may be read through the reference or iterator its append
+    // returned, or by index once the appending thread has been synchronized with (joined, say).
+    // clear(), shrinkToFit() and destruction need the vector to be quiescent.
+    template<typename T, typename Alloc = allocator<T>>
+    struct concurrentVector {
+        private:
+            using myAllocTraits = allocatorTraits<Alloc>;
+
+            static constexpr unsigned firstSegmentBits() noexcept {
+                unsigned bits = 3;
+                while ((size_t{1} << bits) * sizeof(T) < 1024 && bits < 10) ++bits;
+                return bits;
+            }
+        public:
+            using valueType = T;
+            using allocatorType = Alloc;
+            using sizeType = size_t;
+            using differenceType = std::ptrdiff_t;
+            using reference = valueType&;
+            using constReference = const valueType&;
+
+            static constexpr sizeType firstSegmentSize = sizeType{1} << firstSegmentBits();
+
+            template<typename Value>
+            struct basicIterator {
+                private:
+                    using owner = std::conditional_t<std::is_const_v<Value>, const concurrentVector, concurrentVector>;
+                public:
+                    using valueType = removeCV<Value>;
+                    using differenceType = std::ptrdiff_t;
+                    using reference = Value&;
+                    using pointer = Value*;
+                    using iteratorCategory = randomAccessIteratorTag;
+                public:
+                    basicIterator() noexcept = default;
+                    basicIterator(owner* vector, sizeType index) noexcept : mVector{vector}, mIndex{index} {}
+                    template<typename V, typename = enableIfT<std::is_same_v<const V, Value> && !std::is_same_v<V, Value>>>
+                    basicIterator(basicIterator<V> other) noexcept : mVector{other.mVector}, mIndex{other.mIndex} {}
+
+                    reference operator*() const noexcept { return (*mVector)[mIndex]; }
+                    pointer operator->() const noexcept { return &(*mVector)[mIndex]; }
+                    reference operator[](differenceType n) const noexcept { return (*mVector)[mIndex + n]; }
+
+                    basicIterator& operator++() noexcept { ++mIndex; return *this; }
+                    basicIterator operator++(int) noexcept { auto tmp = *this; ++mIndex; return tmp; }
+                    basicIterator& operator--() noexcept { --mIndex; return *this; }
+                    basicIterator operator--(int) noexcept { auto tmp = *this; --mIndex; return tmp; }
+                    basicIterator& operator+=(differenceType n) noexcept { mIndex += n; return *this; }
+                    basicIterator& operator-=(differenceType n) noexcept { mIndex -= n; return *this; }
+
+                    friend basicIterator operator+(basicIterator it, differenceType n) noexcept { return it += n; }
+                    friend basicIterator operator+(differenceType n, basicIterator it) noexcept { return it += n; }
+                    friend basicIterator operator-(basicIterator it, differenceType n) noexcept { return it -= n; }
+                    friend differenceType operator-(basicIterator lhs, basicIterator rhs) noexcept {
+                        return static_cast<differenceType>(lhs.mIndex - rhs.mIndex);
+                    }
+
+                    friend bool operator==(basicIterator lhs, basicIterator rhs) noexcept { return lhs.mIndex == rhs.mIndex; }
+                    friend bool operator!=(basicIterator lhs, basicIterator rhs) noexcept { return lhs.mIndex != rhs.mIndex; }
+                    friend bool operator<(basicIterator lhs, basicIterator rhs) noexcept { return lhs.mIndex < rhs.mIndex; }
+                    friend bool operator>(basicIterator lhs, basicIterator rhs) noexcept { return lhs.mIndex > rhs.mIndex; }
+                    friend bool operator<=(basicIterator lhs, basicIterator rhs) noexcept { return lhs.mIndex <= rhs.mIndex; }
+                    friend bool operator>=(basicIterator lhs, basicIterator rhs) noexcept { return lhs.mIndex >= rhs.mIndex; }
+
+                    sizeType index() const noexcept { return mIndex; }
+                private:
+                    template<typename> friend struct basicIterator;
+
+                    owner* mVector{nullptr};
+                    sizeType mIndex{0};
+            };
+
+            using iterator = basicIterator<T>;
+            using constIterator = basicIterator<const T>;
+        public:
+            concurrentVector() = default;
+            explicit concurrentVector(const Alloc& alloc) : mAlloc{alloc} {}
+
+            concurrentVector(const concurrentVector&) = delete;
+            concurrentVector& operator=(const concurrentVector&) = delete;
+
+            concurrentVector(concurrentVector&& other) noexcept : mAlloc{std::move(other.mAlloc)} { stealFrom(other); }
+
+            concurrentVector& operator=(concurrentVector&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    mAlloc = std::move(other.mAlloc);
+                    stealFrom(other);
+                }
+                return *this;
+            }
+
+            ~concurrentVector() { release(); }
+        public:
+            // Appends build their value before claiming a slot: once claimed, a slot has to be
+            // constructed, so only the final move, which may not throw, happens after the claim.
+            template<typename... Args>
+            iterator emplaceBack(Args&&... args) {
+                if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+                    sizeType index = claim(1);
+                    myAllocTraits::construct(mAlloc, slotAt(index), std::forward<Args>(args)...);
+                    return {this, index};
+                } else {
+                    static_assert(std::is_nothrow_move_constructible_v<T>, "concurrentVector elements need a nothrow move constructor");
+                    T value(std::forward<Args>(args)...);
+                    sizeType index = claim(1);
+                    myAllocTraits::construct(mAlloc, slotAt(index), std::move(value));
+                    return {this, index};
+                }
+            }
+
+            iterator pushBack(const T& value) { return emplaceBack(value); }
+            iterator pushBack(T&& value) { return emplaceBack(std::move(value)); }
+
+            // Appends count value-initialized elements as one contiguous run of indices and
+            // returns an iterator to the first.
+            iterator growBy(sizeType count) {
+                static_assert(std::is_nothrow_default_constructible_v<T>, "growBy needs a nothrow default constructor");
+                sizeType first = claim(count);
+                for (sizeType i = first; i < first + count; ++i) myAllocTraits::construct(mAlloc, slotAt(i));
+                return {this, first};
+            }
+
+            iterator growBy(sizeType count, const T& value) {
+                static_assert(std::is_nothrow_copy_constructible_v<T>, "growBy needs a nothrow copy constructor");
+                sizeType first = claim(count);
+                for (sizeType i = first; i < first + count; ++i) myAllocTraits::construct(mAlloc, slotAt(i), value);
+                return {this, first};
+            }
+
+            // Allocates every segment the first newCap elements need. Safe to call concurrently
+            // with appends, and the way to have allocation failures surface as std::bad_alloc.
+            void reserve(sizeType newCap) {
+                if (newCap == 0) return;
+                for (unsigned k = 0, last = segmentOf(newCap - 1); k <= last; ++k) ensureSegment(k);
+            }
+        public:
+            reference operator[](sizeType pos) noexcept { return *slotAt(pos); }
+            constReference operator[](sizeType pos) const noexcept { return *slotAt(pos); }
+            reference at(sizeType pos) noexcept { return *slotAt(pos); }
+            constReference at(sizeType pos) const noexcept { return *slotAt(pos); }
+
+            reference front() noexcept { return *slotAt(0); }
+            constReference front() const noexcept { return *slotAt(0); }
+            reference back() noexcept { return *slotAt(size() - 1); }
+            constReference back() const noexcept { return *slotAt(size() - 1); }
+        public:
+            iterator begin() noexcept { return {this, 0}; }
+            constIterator begin() const noexcept { return cbegin(); }
+            constIterator cbegin() const noexcept { return {this, 0}; }
+            iterator end() noexcept { return {this, size()}; }
+            constIterator end() const noexcept { return cend(); }
+            constIterator cend() const noexcept { return {this, size()}; }
+        public:
+            sizeType size() const noexcept { return mSize.load(std::memory_order_acquire); }
+            bool empty() const noexcept { return size() == 0; }
+
+            sizeType capacity() const noexcept {
+                sizeType cap = 0;
+                for (unsigned k = 0; k < segmentCount && mSegments[k].load(std::memory_order_acquire); ++k) cap += segmentSize(k);
+                return cap;
+            }
+
+            allocatorType getAllocator() const noexcept { return mAlloc; }
+        public:
+            // Destroys the elements but keeps the segments.
+            void clear() noexcept {
+                destroyElements();
+                mSize.store(0, std::memory_order_relaxed);
+            }
+
+            // Frees the segments beyond those the elements occupy.
+            void shrinkToFit() noexcept {
+                sizeType count = size();
+                unsigned keep = count == 0 ? 0 : segmentOf(count - 1) + 1;
+                for (unsigned k = keep; k < segmentCount; ++k) freeSegment(k);
+            }
+        private:
+            static constexpr unsigned segmentCount = sizeof(sizeType) * 8 - firstSegmentBits() + 1;
+
+            static unsigned segmentOf(sizeType index) noexcept {
+                return _implementation::_bitWidth(index >> firstSegmentBits());
+            }
+
+            static sizeType segmentBase(unsigned k) noexcept {
+                return k == 0 ? 0 : firstSegmentSize << (k - 1);
+            }
+
+            static sizeType segmentSize(unsigned k) noexcept {
+                return k == 0 ? firstSegmentSize : firstSegmentSize << (k - 1);
+            }
+
+            T* slotAt(sizeType index) const noexcept {
+                unsigned k = segmentOf(index);
+                return mSegments[k].load(std::memory_order_acquire) + (index - segmentBase(k));
+            }
+
+            // Claims count consecutive slots and makes sure their segments exist. The slots are
+            // already taken when a segment is allocated, so running out of memory there is fatal
+            // (noexcept); reserve() ahead of time to avoid that.
+            sizeType claim(sizeType count) noexcept {
+                sizeType first = mSize.fetch_add(count, std::memory_order_acq_rel);
+                if (count > 0) {
+                    for (unsigned k = segmentOf(first), last = segmentOf(first + count - 1); k <= last; ++k) ensureSegment(k);
+                }
+                return first;
+            }
+
+            // Threads that race to install the same segment each allocate one; the CAS loser
+            // frees its copy again.
+            void ensureSegment(unsigned k) {
+                if (mSegments[k].load(std::memory_order_acquire)) return;
+                T* segment = myAllocTraits::allocate(mAlloc, segmentSize(k));
+                T* expected = nullptr;
+                if (!mSegments[k].compare_exchange_strong(expected, segment, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    myAllocTraits::deallocate(mAlloc, segment, segmentSize(k));
+                }
+            }
+
+            void freeSegment(unsigned k) noexcept {
+                T* segment = mSegments[k].exchange(nullptr, std::memory_order_relaxed);
+                if (segment) myAllocTraits::deallocate(mAlloc, segment, segmentSize(k));
+            }
+
+            void destroyElements() noexcept {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (sizeType i = 0, count = size(); i < count; ++i) myAllocTraits::destroy(mAlloc, slotAt(i));
+                }
+            }
+
+            void release() noexcept {
+                destroyElements();
+                for (unsigned k = 0; k < segmentCount; ++k) freeSegment(k);
+                mSize.store(0, std::memory_order_relaxed);
+            }
+
+            void stealFrom(concurrentVector& other) noexcept {
+                for (unsigned k = 0; k < segmentCount; ++k) {
+                    mSegments[k].store(other.mSegments[k].exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+                mSize.store(other.mSize.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        private:
+            alignas(cacheLineSize) std::atomic<sizeType> mSize{0};
+            alignas(cacheLineSize) std::atomic<T*> mSegments[segmentCount]{};
+            Alloc mAlloc;
+    };
+}
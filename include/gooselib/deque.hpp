@@ -0,0 +1,420 @@
+#pragma once
+
+#include "memory.hpp"
+#include "iterator.hpp"
+#include "utility.hpp"
+#include <initializer_list>
+#include <cstring>
+#include <type_traits>
+
+namespace goose {
+    // Double-ended queue of fixed-size blocks reached through a map of block pointers. Pushing or
+    // popping at either end is O(1) and never moves other elements, so references stay valid
+    // across pushes and pops at the ends. Emptied blocks are kept on a free list and reused, so a
+    // FIFO that stays around one size stops allocating once it has warmed up; shrinkToFit()
+    // returns them.
+    template<typename T, typename Alloc = allocator<T>>
+    struct deque {
+        private:
+            using myAllocTraits = allocatorTraits<Alloc>;
+            using mapAlloc = typename myAllocTraits::template rebindAlloc<T*>;
+            using mapAllocTraits = allocatorTraits<mapAlloc>;
+
+            // Blocks of about 4 KB, and at least 16 elements, in a power of two so positions split
+            // into block and slot with a shift and a mask.
+            static constexpr size_t computeBlockBits() noexcept {
+                size_t bits = 4;
+                while ((size_t{2} << bits) * sizeof(T) <= 4096) ++bits;
+                return bits;
+            }
+
+            static constexpr size_t blockBits = computeBlockBits();
+            static constexpr size_t blockMask = (size_t{1} << blockBits) - 1;
+            static constexpr size_t minMapSize = 8;
+        public:
+            static constexpr size_t blockSize = size_t{1} << blockBits;
+
+            template<typename Value>
+            struct basicIterator {
+                private:
+                    using block = std::conditional_t<std::is_const_v<Value>, T* const*, T**>;
+                public:
+                    using valueType = removeCV<Value>;
+                    using differenceType = std::ptrdiff_t;
+                    using reference = Value&;
+                    using pointer = Value*;
+                    using iteratorCategory = randomAccessIteratorTag;
+                public:
+                    basicIterator() noexcept = default;
+                    basicIterator(block blockPtr, size_t slot) noexcept : mBlock{blockPtr}, mSlot{slot} {}
+                    template<typename V, typename = enableIfT<std::is_same_v<const V, Value> && !std::is_same_v<V, Value>>>
+                    basicIterator(basicIterator<V> other) noexcept : mBlock{other.mBlock}, mSlot{other.mSlot} {}
+
+                    reference operator*() const noexcept { return (*mBlock)[mSlot]; }
+                    pointer operator->() const noexcept { return *mBlock + mSlot; }
+                    reference operator[](differenceType n) const noexcept { return *(*this + n); }
+
+                    basicIterator& operator++() noexcept {
+                        if (++mSlot == blockSize) {
+                            ++mBlock;
+                            mSlot = 0;
+                        }
+                        return *this;
+                    }
+                    basicIterator operator++(int) noexcept { auto tmp = *this; ++*this; return tmp; }
+
+                    basicIterator& operator--() noexcept {
+                        if (mSlot-- == 0) {
+                            --mBlock;
+                            mSlot = blockMask;
+                        }
+                        return *this;
+                    }
+                    basicIterator operator--(int) noexcept { auto tmp = *this; --*this; return tmp; }
+
+                    basicIterator& operator+=(differenceType n) noexcept {
+                        differenceType offset = static_cast<differenceType>(mSlot) + n;
+                        // Floor division by the block size, also for negative offsets.
+                        differenceType blocks = offset >= 0 ? offset >> blockBits : -((-offset - 1) >> blockBits) - 1;
+                        mBlock += blocks;
+                        mSlot = static_cast<size_t>(offset) & blockMask;
+                        return *this;
+                    }
+                    basicIterator& operator-=(differenceType n) noexcept { return *this += -n; }
+
+                    friend basicIterator operator+(basicIterator it, differenceType n) noexcept { return it += n; }
+                    friend basicIterator operator+(differenceType n, basicIterator it) noexcept { return it += n; }
+                    friend basicIterator operator-(basicIterator it, differenceType n) noexcept { return it -= n; }
+                    friend differenceType operator-(basicIterator lhs, basicIterator rhs) noexcept {
+                        return (lhs.mBlock - rhs.mBlock) * static_cast<differenceType>(blockSize)
+                               + static_cast<differenceType>(lhs.mSlot) - static_cast<differenceType>(rhs.mSlot);
+                    }
+
+                    friend bool operator==(basicIterator lhs, basicIterator rhs) noexcept {
+                        return lhs.mBlock == rhs.mBlock && lhs.mSlot == rhs.mSlot;
+                    }
+                    friend bool operator!=(basicIterator lhs, basicIterator rhs) noexcept { return !(lhs == rhs); }
+                    friend bool operator<(basicIterator lhs, basicIterator rhs) noexcept { return lhs - rhs < 0; }
+                    friend bool operator>(basicIterator lhs, basicIterator rhs) noexcept { return lhs - rhs > 0; }
+                    friend bool operator<=(basicIterator lhs, basicIterator rhs) noexcept { return lhs - rhs <= 0; }
+                    friend bool operator>=(basicIterator lhs, basicIterator rhs) noexcept { return lhs - rhs >= 0; }
+                private:
+                    template<typename> friend struct basicIterator;
+
+                    block mBlock{nullptr};
+                    size_t mSlot{0};
+            };
+        public:
+            using valueType = T;
+            using allocatorType = Alloc;
+            using sizeType = size_t;
+            using differenceType = std::ptrdiff_t;
+            using reference = valueType&;
+            using constReference = const valueType&;
+            using iterator = basicIterator<T>;
+            using constIterator = basicIterator<const T>;
+            using reverseIterator = goose::reverseIterator<iterator>;
+            using constReverseIterator = goose::reverseIterator<constIterator>;
+        public:
+            deque() noexcept(std::is_nothrow_default_constructible_v<Alloc>) = default;
+            deque(const Alloc& alloc) : mAlloc{alloc} {}
+
+            deque(sizeType count, const T& value, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
+                resize(count, value);
+            }
+
+            deque(sizeType count, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
+                resize(count);
+            }
+
+            template<typename InputIt, typename = enableIfT<!std::is_integral_v<InputIt>>>
+            deque(InputIt first, InputIt last, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
+                assign(first, last);
+            }
+
+            deque(std::initializer_list<T> list, const Alloc& alloc = Alloc()) : deque(list.begin(), list.end(), alloc) {}
+
+            deque(const deque& other) : deque(other.begin(), other.end(), other.mAlloc) {}
+
+            deque(deque&& other) noexcept : mAlloc{std::move(other.mAlloc)} { takeFrom(other); }
+
+            ~deque() { release(); }
+
+            deque& operator=(const deque& other) {
+                if (this == &other) return *this;
+                if constexpr (myAllocTraits::propagateOnContainerCopyAssignment::value) {
+                    if (mAlloc != other.mAlloc) release();
+                    mAlloc = other.mAlloc;
+                }
+                assign(other.begin(), other.end());
+                return *this;
+            }
+
+            deque& operator=(deque&& other) noexcept(myAllocTraits::propagateOnContainerMoveAssignment::value
+                                                     || myAllocTraits::isAlwaysEqual::value) {
+                if (this == &other) return *this;
+                if constexpr (myAllocTraits::propagateOnContainerMoveAssignment::value) {
+                    release();
+                    mAlloc = std::move(other.mAlloc);
+                    takeFrom(other);
+                } else if constexpr (myAllocTraits::isAlwaysEqual::value) {
+                    release();
+                    takeFrom(other);
+                } else {
+                    if (mAlloc == other.mAlloc) {
+                        release();
+                        takeFrom(other);
+                    } else {
+                        // Blocks from other's allocator cannot be handed to ours, so move each element.
+                        clear();
+                        for (auto& item : other) emplaceBack(std::move(item));
+                        other.clear();
+                    }
+                }
+                return *this;
+            }
+
+            deque& operator=(std::initializer_list<T> list) {
+                assign(list.begin(), list.end());
+                return *this;
+            }
+        public:
+            reference operator[](sizeType pos) noexcept { return *slotAt(pos); }
+            constReference operator[](sizeType pos) const noexcept { return *slotAt(pos); }
+            reference at(sizeType pos) noexcept { return *slotAt(pos); }
+            constReference at(sizeType pos) const noexcept { return *slotAt(pos); }
+
+            reference front() noexcept { return mMap[mFirstBlock][mOffset]; }
+            constReference front() const noexcept { return mMap[mFirstBlock][mOffset]; }
+            reference back() noexcept { return *slotAt(mSize - 1); }
+            constReference back() const noexcept { return *slotAt(mSize - 1); }
+        public:
+            iterator begin() noexcept { return {mMap + mFirstBlock, mOffset}; }
+            constIterator begin() const noexcept { return cbegin(); }
+            constIterator cbegin() const noexcept { return {mMap + mFirstBlock, mOffset}; }
+            iterator end() noexcept { return begin() + static_cast<differenceType>(mSize); }
+            constIterator end() const noexcept { return cend(); }
+            constIterator cend() const noexcept { return cbegin() + static_cast<differenceType>(mSize); }
+            reverseIterator rbegin() { return end(); }
+            reverseIterator rend() { return begin(); }
+            constReverseIterator rbegin() const { return crbegin(); }
+            constReverseIterator rend() const { return crend(); }
+            constReverseIterator crbegin() const { return cend(); }
+            constReverseIterator crend() const { return cbegin(); }
+        public:
+            sizeType size() const noexcept { return mSize; }
+            bool empty() const noexcept { return mSize == 0; }
+        public:
+            template<typename... Args>
+            reference emplaceBack(Args&&... args) {
+                sizeType pos = mOffset + mSize;
+                bool newBlock = mSize == 0 || (pos & blockMask) == 0;
+                if (mSize == 0) {
+                    // Start an empty deque in the middle of the map, so it can grow either way.
+                    startInMiddle();
+                    mOffset = 0;
+                    pos = 0;
+                } else if (newBlock) {
+                    reserveMapBack();
+                }
+                T** block = mMap + mFirstBlock + (pos >> blockBits);
+                if (newBlock) *block = acquireBlock();
+                try {
+                    myAllocTraits::construct(mAlloc, *block + (pos & blockMask), std::forward<Args>(args)...);
+                } catch (...) {
+                    if (newBlock) releaseBlock(*block);
+                    throw;
+                }
+                ++mSize;
+                return (*block)[pos & blockMask];
+            }
+
+            template<typename... Args>
+            reference emplaceFront(Args&&... args) {
+                bool newBlock = mSize == 0 || mOffset == 0;
+                if (mSize == 0) {
+                    startInMiddle();
+                } else if (newBlock) {
+                    reserveMapFront();
+                }
+                T** block = mMap + mFirstBlock - (newBlock && mSize > 0);
+                sizeType slot = newBlock ? blockMask : mOffset - 1;
+                if (newBlock) *block = acquireBlock();
+                try {
+                    myAllocTraits::construct(mAlloc, *block + slot, std::forward<Args>(args)...);
+                } catch (...) {
+                    if (newBlock) releaseBlock(*block);
+                    throw;
+                }
+                mFirstBlock = static_cast<sizeType>(block - mMap);
+                mOffset = slot;
+                ++mSize;
+                return (*block)[slot];
+            }
+
+            void pushBack(const T& value) { emplaceBack(value); }
+            void pushBack(T&& value) { emplaceBack(std::move(value)); }
+            void pushFront(const T& value) { emplaceFront(value); }
+            void pushFront(T&& value) { emplaceFront(std::move(value)); }
+
+            void popBack() noexcept {
+                sizeType pos = mOffset + --mSize;
+                T** block = mMap + mFirstBlock + (pos >> blockBits);
+                myAllocTraits::destroy(mAlloc, *block + (pos & blockMask));
+                if ((pos & blockMask) == 0 || mSize == 0) releaseBlock(*block);
+            }
+
+            void popFront() noexcept {
+                T** block = mMap + mFirstBlock;
+                myAllocTraits::destroy(mAlloc, *block + mOffset);
+                --mSize;
+                if (++mOffset == blockSize || mSize == 0) {
+                    releaseBlock(*block);
+                    ++mFirstBlock;
+                    mOffset = 0;
+                }
+            }
+
+            void clear() noexcept {
+                while (mSize) popBack();
+            }
+
+            void resize(sizeType count) {
+                while (mSize > count) popBack();
+                while (mSize < count) emplaceBack();
+            }
+
+            void resize(sizeType count, const T& value) {
+                while (mSize > count) popBack();
+                while (mSize < count) emplaceBack(value);
+            }
+
+            template<typename InputIt, typename = enableIfT<!std::is_integral_v<InputIt>>>
+            void assign(InputIt first, InputIt last) {
+                clear();
+                for (; first != last; ++first) emplaceBack(*first);
+            }
+
+            // Frees the spare blocks and shrinks the map to what the elements need.
+            void shrinkToFit() noexcept {
+                while (mSpareBlocks) myAllocTraits::deallocate(mAlloc, popSpare(), blockSize);
+                if (mSize == 0 && mMap) {
+                    mapAlloc alloc(mAlloc);
+                    mapAllocTraits::deallocate(alloc, mMap, mMapSize);
+                    mMap = nullptr;
+                    mMapSize = 0;
+                    mFirstBlock = 0;
+                }
+            }
+
+            // Unless the allocator propagates on swap, the two allocators must compare equal.
+            void swap(deque& other) noexcept {
+                goose::swap(mMap, other.mMap);
+                goose::swap(mMapSize, other.mMapSize);
+                goose::swap(mFirstBlock, other.mFirstBlock);
+                goose::swap(mOffset, other.mOffset);
+                goose::swap(mSize, other.mSize);
+                goose::swap(mSpareBlocks, other.mSpareBlocks);
+                if constexpr (myAllocTraits::propagateOnContainerSwap::value) {
+                    goose::swap(mAlloc, other.mAlloc);
+                }
+            }
+
+            allocatorType getAllocator() const noexcept { return mAlloc; }
+        private:
+            T* slotAt(sizeType index) const noexcept {
+                sizeType pos = mOffset + index;
+                return mMap[mFirstBlock + (pos >> blockBits)] + (pos & blockMask);
+            }
+
+            sizeType usedBlocks() const noexcept {
+                return mSize == 0 ? 0 : ((mOffset + mSize - 1) >> blockBits) + 1;
+            }
+
+            // Spare blocks form a list threaded through their own first bytes.
+            T* acquireBlock() {
+                return mSpareBlocks ? popSpare() : myAllocTraits::allocate(mAlloc, blockSize);
+            }
+
+            void releaseBlock(T*& block) noexcept {
+                std::memcpy(static_cast<void*>(block), &mSpareBlocks, sizeof(T*));
+                mSpareBlocks = block;
+                block = nullptr;
+            }
+
+            T* popSpare() noexcept {
+                T* block = mSpareBlocks;
+                std::memcpy(&mSpareBlocks, static_cast<const void*>(block), sizeof(T*));
+                return block;
+            }
+
+            // With no blocks in use every map entry is null, so any position will do.
+            void startInMiddle() {
+                if (!mMap) reserveMap(1);
+                mFirstBlock = mMapSize / 2;
+            }
+
+            void reserveMapBack() {
+                if (mFirstBlock + usedBlocks() == mMapSize) reserveMap(usedBlocks() + 1);
+            }
+
+            void reserveMapFront() {
+                if (mFirstBlock == 0) reserveMap(usedBlocks() + 1);
+            }
+
+            // Makes the map hold at least blocks blocks with room at both ends. A map that is at
+            // most half full has its pointers recentred in place; otherwise it doubles.
+            void reserveMap(sizeType blocks) {
+                sizeType used = usedBlocks();
+                sizeType first = mFirstBlock;
+                if (mMapSize >= 2 * blocks) {
+                    sizeType newFirst = (mMapSize - used) / 2;
+                    if (used) std::memmove(static_cast<void*>(mMap + newFirst), static_cast<const void*>(mMap + first), used * sizeof(T*));
+                    for (sizeType i = 0; i < mMapSize; ++i) {
+                        if (i < newFirst || i >= newFirst + used) mMap[i] = nullptr;
+                    }
+                    mFirstBlock = newFirst;
+                    return;
+                }
+                sizeType newSize = mMapSize ? mMapSize * 2 : minMapSize;
+                while (newSize < 2 * blocks) newSize *= 2;
+                mapAlloc alloc(mAlloc);
+                T** newMap = mapAllocTraits::allocate(alloc, newSize);
+                sizeType newFirst = (newSize - used) / 2;
+                for (sizeType i = 0; i < newSize; ++i) newMap[i] = nullptr;
+                for (sizeType i = 0; i < used; ++i) newMap[newFirst + i] = mMap[first + i];
+                if (mMap) mapAllocTraits::deallocate(alloc, mMap, mMapSize);
+                mMap = newMap;
+                mMapSize = newSize;
+                mFirstBlock = newFirst;
+            }
+
+            void release() noexcept {
+                clear();
+                shrinkToFit();
+            }
+
+            void takeFrom(deque& other) noexcept {
+                mMap = goose::exchange(other.mMap, nullptr);
+                mMapSize = goose::exchange(other.mMapSize, 0);
+                mFirstBlock = goose::exchange(other.mFirstBlock, 0);
+                mOffset = goose::exchange(other.mOffset, 0);
+                mSize = goose::exchange(other.mSize, 0);
+                mSpareBlocks = goose::exchange(other.mSpareBlocks, nullptr);
+            }
+        private:
+            T** mMap{nullptr};
+            sizeType mMapSize{0};
+            sizeType mFirstBlock{0};
+            // Slot of the front element within the first block.
+            sizeType mOffset{0};
+            sizeType mSize{0};
+            T* mSpareBlocks{nullptr};
+            Alloc mAlloc;
+    };
+
+    template<typename T, typename Alloc>
+    void swap(deque<T, Alloc>& lhs, deque<T, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+}
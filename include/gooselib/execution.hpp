@@ -0,0 +1,257 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "sort.hpp"
+#include "thread_pool.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <type_traits>
+
+namespace goose {
+    namespace execution {
+        struct sequencedPolicy { };
+
+        // Runs on threadPool::global() unless pointed at another pool with on(). grain is the
+        // smallest number of elements handed to one task; 0 picks one from the range size.
+        struct parallelPolicy {
+            threadPool* pool{nullptr};
+            size_t grain{0};
+
+            constexpr parallelPolicy on(threadPool& target) const noexcept { return {&target, grain}; }
+            constexpr parallelPolicy withGrain(size_t elements) const noexcept { return {pool, elements}; }
+        };
+
+        inline constexpr sequencedPolicy seq{};
+        inline constexpr parallelPolicy par{};
+
+        template<typename T>
+        struct isExecutionPolicy : falseType { };
+        template<>
+        struct isExecutionPolicy<sequencedPolicy> : trueType { };
+        template<>
+        struct isExecutionPolicy<parallelPolicy> : trueType { };
+
+        template<typename T>
+        inline constexpr bool isExecutionPolicyV = isExecutionPolicy<removeCV<removeReference<T>>>::value;
+    }
+
+    namespace _implementation {
+        template<typename Policy, typename R = void>
+        using _enableIfPolicy = enableIfT<execution::isExecutionPolicyV<Policy>, R>;
+
+        template<typename Policy>
+        inline constexpr bool _isParallel = std::is_same_v<removeCV<removeReference<Policy>>, execution::parallelPolicy>;
+
+        template<typename It>
+        void _requireRandomAccess() {
+            using category = typename iteratorTraits<It>::iteratorCategory;
+            static_assert(std::is_base_of_v<randomAccessIteratorTag, category>,
+                          "parallel algorithms split their range and need random access iterators");
+        }
+
+        inline threadPool& _poolOf(const execution::parallelPolicy& policy) {
+            return policy.pool ? *policy.pool : threadPool::global();
+        }
+
+        // Ranges smaller than this run on the calling thread; the fork/join cost would dominate.
+        inline constexpr size_t _minimumGrain = 2048;
+
+        // Aim for several chunks per worker so stealing can even out uneven chunk costs.
+        inline size_t _grainFor(const execution::parallelPolicy& policy, size_t length) {
+            if (policy.grain) return policy.grain;
+            size_t chunks = _poolOf(policy).size() * 8;
+            size_t grain = (length + chunks - 1) / chunks;
+            return grain < _minimumGrain ? _minimumGrain : grain;
+        }
+
+        // Splits [0, length) into contiguous chunks of about grain elements and returns their count.
+        inline size_t _chunkCount(size_t length, size_t grain) {
+            return length == 0 ? 0 : (length + grain - 1) / grain;
+        }
+    }
+
+    template<class Policy, class It, class F>
+    _implementation::_enableIfPolicy<Policy> forEach(Policy&& policy, It first, It last, F f) {
+        if constexpr (_implementation::_isParallel<Policy>) {
+            _implementation::_requireRandomAccess<It>();
+            size_t length = goose::distance(first, last);
+            parallelFor(_implementation::_poolOf(policy), 0, length, _implementation::_grainFor(policy, length),
+                        [&](size_t begin, size_t end) { goose::forEach(first + begin, first + end, f); });
+        } else {
+            goose::forEach(first, last, f);
+        }
+    }
+
+    template<class Policy, class It, class OutIt, class UnaryOp>
+    _implementation::_enableIfPolicy<Policy, OutIt> transform(Policy&& policy, It first, It last, OutIt out, UnaryOp op) {
+        if constexpr (_implementation::_isParallel<Policy>) {
+            _implementation::_requireRandomAccess<It>();
+            _implementation::_requireRandomAccess<OutIt>();
+            size_t length = goose::distance(first, last);
+            parallelFor(_implementation::_poolOf(policy), 0, length, _implementation::_grainFor(policy, length),
+                        [&](size_t begin, size_t end) { goose::transform(first + begin, first + end, out + begin, op); });
+            return out + length;
+        } else {
+            return goose::transform(first, last, out, op);
+        }
+    }
+
+    // op must be associative and commutative enough that the order partial results are combined in does not matter.
+    template<class Policy, class It, class T, class ReduceOp, class TransformOp>
+    _implementation::_enableIfPolicy<Policy, T> transformReduce(Policy&& policy, It first, It last, T init,
+                                                                ReduceOp reduceOp, TransformOp transformOp) {
+        if constexpr (_implementation::_isParallel<Policy>) {
+            _implementation::_requireRandomAccess<It>();
+            size_t length = goose::distance(first, last);
+            size_t grain = _implementation::_grainFor(policy, length);
+            size_t chunks = _implementation::_chunkCount(length, grain);
+            if (chunks <= 1) return goose::transformReduce(first, last, std::move(init), reduceOp, transformOp);
+
+            // Every chunk seeds its partial with its own first element, so no identity value is needed.
+            goose::vector<T> partials;
+            partials.reserve(chunks);
+            for (size_t chunk = 0; chunk < chunks; ++chunk) partials.emplaceBack(transformOp(*(first + chunk * grain)));
+            parallelFor(_implementation::_poolOf(policy), 0, chunks, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+                for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+                    size_t begin = chunk * grain;
+                    size_t end = begin + grain < length ? begin + grain : length;
+                    partials[chunk] = goose::transformReduce(first + begin + 1, first + end, std::move(partials[chunk]),
+                                                             reduceOp, transformOp);
+                }
+            });
+            for (auto& partial : partials) init = reduceOp(std::move(init), std::move(partial));
+            return init;
+        } else {
+            return goose::transformReduce(first, last, std::move(init), reduceOp, transformOp);
+        }
+    }
+
+    template<class Policy, class It, class T, class BinaryOp>
+    _implementation::_enableIfPolicy<Policy, T> reduce(Policy&& policy, It first, It last, T init, BinaryOp op) {
+        return goose::transformReduce(std::forward<Policy>(policy), first, last, std::move(init), op,
+                                      [](const auto& value) -> const auto& { return value; });
+    }
+
+    template<class Policy, class It, class T>
+    _implementation::_enableIfPolicy<Policy, T> reduce(Policy&& policy, It first, It last, T init) {
+        return goose::reduce(std::forward<Policy>(policy), first, last, std::move(init),
+                             [](const auto& a, const auto& b) { return a + b; });
+    }
+
+    // Two passes: each chunk is reduced in parallel, the chunk totals are scanned serially, and
+    // each chunk is then scanned again in parallel starting from the total of everything before it.
+    template<class Policy, class It, class OutIt, class BinaryOp>
+    _implementation::_enableIfPolicy<Policy, OutIt> inclusiveScan(Policy&& policy, It first, It last, OutIt out, BinaryOp op) {
+        if constexpr (_implementation::_isParallel<Policy>) {
+            _implementation::_requireRandomAccess<It>();
+            _implementation::_requireRandomAccess<OutIt>();
+            using T = typename iteratorTraits<It>::valueType;
+            size_t length = goose::distance(first, last);
+            size_t grain = _implementation::_grainFor(policy, length);
+            size_t chunks = _implementation::_chunkCount(length, grain);
+            if (chunks <= 1) return goose::inclusiveScan(first, last, out, op);
+
+            threadPool& pool = _implementation::_poolOf(policy);
+            // The last chunk's total is never needed by anyone after it.
+            goose::vector<T> totals;
+            totals.reserve(chunks - 1);
+            for (size_t chunk = 0; chunk + 1 < chunks; ++chunk) totals.emplaceBack(*(first + chunk * grain));
+            parallelFor(pool, 0, chunks - 1, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+                for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+                    size_t begin = chunk * grain;
+                    for (size_t i = begin + 1; i < begin + grain; ++i) totals[chunk] = op(std::move(totals[chunk]), *(first + i));
+                }
+            });
+            for (size_t chunk = 1; chunk + 1 < chunks; ++chunk) {
+                totals[chunk] = op(totals[chunk - 1], std::move(totals[chunk]));
+            }
+            parallelFor(pool, 0, chunks, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+                for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+                    size_t begin = chunk * grain;
+                    size_t end = begin + grain < length ? begin + grain : length;
+                    if (chunk == 0) {
+                        goose::inclusiveScan(first, first + end, out, op);
+                        continue;
+                    }
+                    T running = totals[chunk - 1];
+                    for (size_t i = begin; i < end; ++i) {
+                        running = op(std::move(running), *(first + i));
+                        *(out + i) = running;
+                    }
+                }
+            });
+            return out + length;
+        } else {
+            return goose::inclusiveScan(first, last, out, op);
+        }
+    }
+
+    template<class Policy, class It, class OutIt>
+    _implementation::_enableIfPolicy<Policy, OutIt> inclusiveScan(Policy&& policy, It first, It last, OutIt out) {
+        return goose::inclusiveScan(std::forward<Policy>(policy), first, last, out,
+                                    [](const auto& a, const auto& b) { return a + b; });
+    }
+
+    // Sorts independent chunks in parallel, then merges neighbouring runs pairwise through a
+    // scratch buffer, doubling the run length each round. Only contiguous ranges are split;
+    // others, like deque, sort on the calling thread.
+    template<class Policy, class It, class Compare>
+    _implementation::_enableIfPolicy<Policy> sort(Policy&& policy, It first, It last, Compare comp) {
+        _implementation::_requireRandomAccess<It>();
+        if constexpr (_implementation::_isParallel<Policy> && _implementation::_contiguous<It>::value) {
+            using T = _implementation::_contiguousValue<It>;
+            size_t length = goose::distance(first, last);
+            size_t grain = _implementation::_grainFor(policy, length);
+            size_t chunks = _implementation::_chunkCount(length, grain);
+            if (chunks > 1) {
+                T* base = _implementation::toPointer(first);
+                threadPool& pool = _implementation::_poolOf(policy);
+                parallelFor(pool, 0, chunks, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+                    for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+                        size_t begin = chunk * grain;
+                        size_t end = begin + grain < length ? begin + grain : length;
+                        goose::sort(base + begin, base + end, comp);
+                    }
+                });
+
+                allocator<T> alloc;
+                T* scratch = alloc.allocate(length);
+                size_t built = 0;
+                try {
+                    for (; built < length; ++built) constructAt(scratch + built, std::move(base[built]));
+                    T* from = scratch;
+                    T* to = base;
+                    for (size_t run = grain; run < length; run *= 2) {
+                        size_t pairs = (length + 2 * run - 1) / (2 * run);
+                        parallelFor(pool, 0, pairs, 1, [&](size_t pairBegin, size_t pairEnd) {
+                            for (size_t pair = pairBegin; pair < pairEnd; ++pair) {
+                                size_t begin = pair * 2 * run;
+                                size_t mid = begin + run < length ? begin + run : length;
+                                size_t end = mid + run < length ? mid + run : length;
+                                std::merge(std::make_move_iterator(from + begin), std::make_move_iterator(from + mid),
+                                           std::make_move_iterator(from + mid), std::make_move_iterator(from + end),
+                                           to + begin, comp);
+                            }
+                        });
+                        goose::swap(from, to);
+                    }
+                    if (from != base) std::move(from, from + length, base);
+                } catch (...) {
+                    for (size_t i = 0; i < built; ++i) destroyAt(scratch + i);
+                    alloc.deallocate(scratch, length);
+                    throw;
+                }
+                for (size_t i = 0; i < length; ++i) destroyAt(scratch + i);
+                alloc.deallocate(scratch, length);
+                return;
+            }
+        }
+        goose::sort(first, last, comp);
+    }
+
+    template<class Policy, class It>
+    _implementation::_enableIfPolicy<Policy> sort(Policy&& policy, It first, It last) {
+        goose::sort(std::forward<Policy>(policy), first, last, _implementation::_lessThan{});
+    }
+}
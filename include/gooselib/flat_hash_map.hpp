@@ -0,0 +1,643 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "utility.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace goose {
+    namespace _implementation {
+        // One control byte per slot: empty and deleted are negative, a full slot stores the low
+        // seven bits of its hash (h2) so a probe can reject almost every candidate without
+        // touching the slot itself.
+        inline constexpr int8_t _ctrlEmpty = -128;
+        inline constexpr int8_t _ctrlDeleted = -2;
+
+        struct _probeGroup {
+            static constexpr size_t width = 16;
+
+#if defined(__SSE2__)
+            explicit _probeGroup(const int8_t* ctrl) noexcept : mCtrl{_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))} {}
+
+            uint32_t match(int8_t h2) const noexcept {
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), mCtrl)));
+            }
+
+            uint32_t matchEmpty() const noexcept { return match(_ctrlEmpty); }
+
+            // Empty and deleted are the only control values below -1.
+            uint32_t matchEmptyOrDeleted() const noexcept {
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), mCtrl)));
+            }
+
+            __m128i mCtrl;
+#else
+            explicit _probeGroup(const int8_t* ctrl) noexcept { std::memcpy(mCtrl, ctrl, width); }
+
+            uint32_t match(int8_t h2) const noexcept {
+                uint32_t mask = 0;
+                for (size_t i = 0; i < width; ++i) mask |= uint32_t(mCtrl[i] == h2) << i;
+                return mask;
+            }
+
+            uint32_t matchEmpty() const noexcept { return match(_ctrlEmpty); }
+
+            uint32_t matchEmptyOrDeleted() const noexcept {
+                uint32_t mask = 0;
+                for (size_t i = 0; i < width; ++i) mask |= uint32_t(mCtrl[i] < -1) << i;
+                return mask;
+            }
+
+            int8_t mCtrl[width];
+#endif
+        };
+
+        // std::hash is the identity for integers, which would leave h2 and the low bits of h1
+        // badly distributed. Folding a 128-bit multiply spreads every input bit across the word.
+        inline uint64_t _mixHash(uint64_t hash) noexcept {
+            __uint128_t product = static_cast<__uint128_t>(hash) * 0x9E3779B97F4A7C15ull;
+            return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+        }
+
+        template<typename T, typename = void>
+        struct _isTransparent : falseType { };
+        template<typename T>
+        struct _isTransparent<T, voidT<typename T::is_transparent>> : trueType { };
+        template<typename T>
+        struct _isTransparent<T, voidT<typename T::isTransparent>> : trueType { };
+
+        // A map slot holds the pair with a const key, which is all users ever see. The mutable
+        // view exists only so a rehash can move the key out of a slot it is about to destroy,
+        // the same punning SwissTable uses; the two pairs must therefore share a layout.
+        template<typename Key, typename Value>
+        union _mapSlot {
+            _mapSlot() noexcept {}
+            ~_mapSlot() {}
+
+            std::pair<const Key, Value> value;
+            std::pair<Key, Value> mutableValue;
+        };
+
+        template<typename Key, typename Value>
+        struct _mapPolicy {
+            using keyType = Key;
+            using valueType = std::pair<const Key, Value>;
+            using slotType = _mapSlot<Key, Value>;
+            static_assert(sizeof(valueType) == sizeof(std::pair<Key, Value>) && alignof(valueType) == alignof(std::pair<Key, Value>),
+                          "flatHashMap needs pair<const Key, Value> and pair<Key, Value> to share a layout");
+
+            static constexpr bool nothrowTransfer = std::is_nothrow_move_constructible_v<std::pair<Key, Value>>;
+
+            static const Key& key(const valueType& value) noexcept { return value.first; }
+            static valueType& element(slotType& slot) noexcept { return slot.value; }
+            static const valueType& element(const slotType& slot) noexcept { return slot.value; }
+
+            // Move-constructs dst from src; src is left for the caller to destroy.
+            template<typename Alloc>
+            static void transfer(Alloc& alloc, slotType* dst, slotType* src) {
+                allocatorTraits<Alloc>::construct(alloc, &dst->mutableValue, std::move(src->mutableValue));
+            }
+        };
+
+        template<typename Key>
+        struct _setPolicy {
+            using keyType = Key;
+            using valueType = Key;
+            using slotType = Key;
+
+            static constexpr bool nothrowTransfer = std::is_nothrow_move_constructible_v<Key>;
+
+            static const Key& key(const valueType& value) noexcept { return value; }
+            static valueType& element(slotType& slot) noexcept { return slot; }
+            static const valueType& element(const slotType& slot) noexcept { return slot; }
+
+            template<typename Alloc>
+            static void transfer(Alloc& alloc, slotType* dst, slotType* src) {
+                allocatorTraits<Alloc>::construct(alloc, dst, std::move(*src));
+            }
+        };
+
+        // Open-addressing table shared by flatHashMap and flatHashSet. Capacity is a power of two
+        // of at least one group; the first group's control bytes are mirrored past the end so a
+        // probe window that wraps around can still be read with a single unaligned load.
+        template<typename Policy, typename Hash, typename KeyEqual, typename Alloc>
+        struct _rawHashTable {
+            public:
+                using keyType = typename Policy::keyType;
+                using valueType = typename Policy::valueType;
+                using sizeType = size_t;
+                using hasher = Hash;
+                using keyEqual = KeyEqual;
+                using allocatorType = Alloc;
+            private:
+                using slotType = typename Policy::slotType;
+                using valueTraits = allocatorTraits<Alloc>;
+                using slotAlloc = typename valueTraits::template rebindAlloc<slotType>;
+                using slotTraits = allocatorTraits<slotAlloc>;
+                using ctrlAlloc = typename valueTraits::template rebindAlloc<int8_t>;
+                using ctrlTraits = allocatorTraits<ctrlAlloc>;
+                static constexpr size_t groupWidth = _probeGroup::width;
+                static constexpr size_t npos = ~size_t{0};
+
+                // A rehash moves slots only when neither hashing nor moving can throw; otherwise it
+                // copies, so a failure part way through leaves the old table intact. Move-only
+                // slots are moved regardless.
+                static constexpr bool moveOnRehash =
+                    (Policy::nothrowTransfer && std::is_nothrow_invocable_v<const Hash&, const keyType&>)
+                    || !std::is_copy_constructible_v<valueType>;
+
+                template<typename K>
+                using _lookupKey = conditional<_isTransparent<Hash>::value && _isTransparent<KeyEqual>::value, K, keyType>;
+            public:
+                template<bool Const>
+                struct basicIterator {
+                    public:
+                        using valueType = conditional<Const, const typename Policy::valueType, typename Policy::valueType>;
+                        using differenceType = std::ptrdiff_t;
+                        using reference = valueType&;
+                        using pointer = valueType*;
+                        using iteratorCategory = forwardIteratorTag;
+                    private:
+                        using slotPointer = conditional<Const, const slotType*, slotType*>;
+                    public:
+                        basicIterator() noexcept = default;
+                        basicIterator(const int8_t* ctrl, const int8_t* ctrlEnd, slotPointer slot) noexcept
+                            : mCtrl{ctrl}, mCtrlEnd{ctrlEnd}, mSlot{slot} { skipEmpty(); }
+                        template<bool WasConst, typename = enableIfT<Const && !WasConst>>
+                        basicIterator(const basicIterator<WasConst>& other) noexcept
+                            : mCtrl{other.mCtrl}, mCtrlEnd{other.mCtrlEnd}, mSlot{other.mSlot} {}
+                    public:
+                        basicIterator& operator++() {
+                            ++mCtrl;
+                            ++mSlot;
+                            skipEmpty();
+                            return *this;
+                        }
+                        basicIterator operator++(int) {
+                            auto tmp = *this;
+                            ++*this;
+                            return tmp;
+                        }
+
+                        reference operator*() const { return Policy::element(*mSlot); }
+                        pointer operator->() const { return &Policy::element(*mSlot); }
+
+                        friend bool operator==(const basicIterator& lhs, const basicIterator& rhs) { return lhs.mCtrl == rhs.mCtrl; }
+                        friend bool operator!=(const basicIterator& lhs, const basicIterator& rhs) { return lhs.mCtrl != rhs.mCtrl; }
+                    private:
+                        void skipEmpty() noexcept {
+                            while (mCtrl != mCtrlEnd && *mCtrl < 0) {
+                                ++mCtrl;
+                                ++mSlot;
+                            }
+                        }
+
+                        template<bool> friend struct basicIterator;
+                        friend struct _rawHashTable;
+
+                        const int8_t* mCtrl{nullptr};
+                        const int8_t* mCtrlEnd{nullptr};
+                        slotPointer mSlot{nullptr};
+                };
+
+                using iterator = basicIterator<false>;
+                using constIterator = basicIterator<true>;
+            public:
+                _rawHashTable() = default;
+                explicit _rawHashTable(sizeType bucketCount, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+                                       const Alloc& alloc = Alloc())
+                    : mHash{hash}, mEqual{equal}, mAlloc{alloc} {
+                    reserve(bucketCount);
+                }
+
+                _rawHashTable(const _rawHashTable& other) : mHash{other.mHash}, mEqual{other.mEqual}, mAlloc{other.mAlloc} {
+                    // The destructor does not run if this throws, so undo the partial copy by hand.
+                    try {
+                        reserve(other.mSize);
+                        for (const auto& value : other) insertUnique(hashOf(Policy::key(value)), value);
+                    } catch (...) {
+                        destroyAll();
+                        throw;
+                    }
+                }
+
+                _rawHashTable(_rawHashTable&& other) noexcept
+                    : mCtrl{goose::exchange(other.mCtrl, nullptr)}, mSlots{goose::exchange(other.mSlots, nullptr)},
+                      mCapacity{goose::exchange(other.mCapacity, 0)}, mSize{goose::exchange(other.mSize, 0)},
+                      mGrowthLeft{goose::exchange(other.mGrowthLeft, 0)},
+                      mHash{std::move(other.mHash)}, mEqual{std::move(other.mEqual)}, mAlloc{std::move(other.mAlloc)} {}
+
+                _rawHashTable& operator=(const _rawHashTable& other) {
+                    if (this == &other) return *this;
+                    _rawHashTable copy(other);
+                    swap(copy);
+                    return *this;
+                }
+
+                _rawHashTable& operator=(_rawHashTable&& other) noexcept {
+                    if (this == &other) return *this;
+                    destroyAll();
+                    mCtrl = goose::exchange(other.mCtrl, nullptr);
+                    mSlots = goose::exchange(other.mSlots, nullptr);
+                    mCapacity = goose::exchange(other.mCapacity, 0);
+                    mSize = goose::exchange(other.mSize, 0);
+                    mGrowthLeft = goose::exchange(other.mGrowthLeft, 0);
+                    mHash = std::move(other.mHash);
+                    mEqual = std::move(other.mEqual);
+                    mAlloc = std::move(other.mAlloc);
+                    return *this;
+                }
+
+                ~_rawHashTable() { destroyAll(); }
+            public:
+                iterator begin() noexcept { return {mCtrl, mCtrl + mCapacity, mSlots}; }
+                iterator end() noexcept { return {mCtrl + mCapacity, mCtrl + mCapacity, mSlots + mCapacity}; }
+                constIterator begin() const noexcept { return cbegin(); }
+                constIterator end() const noexcept { return cend(); }
+                constIterator cbegin() const noexcept { return {mCtrl, mCtrl + mCapacity, mSlots}; }
+                constIterator cend() const noexcept { return {mCtrl + mCapacity, mCtrl + mCapacity, mSlots + mCapacity}; }
+            public:
+                sizeType size() const noexcept { return mSize; }
+                bool empty() const noexcept { return mSize == 0; }
+                sizeType capacity() const noexcept { return mCapacity; }
+                float loadFactor() const noexcept { return mCapacity ? static_cast<float>(mSize) / mCapacity : 0.0f; }
+
+                // Makes room for count elements in total, so that many inserts never rehash.
+                void reserve(sizeType count) {
+                    if (count <= mSize + mGrowthLeft) return;
+                    resize(capacityFor(count));
+                }
+
+                void clear() noexcept {
+                    for (size_t i = 0; i < mCapacity; ++i) {
+                        if (mCtrl[i] >= 0) destroySlot(mSlots + i);
+                    }
+                    if (mCapacity) std::memset(mCtrl, static_cast<unsigned char>(_ctrlEmpty), mCapacity + groupWidth);
+                    mSize = 0;
+                    mGrowthLeft = maxLoad(mCapacity);
+                }
+
+                void swap(_rawHashTable& other) noexcept {
+                    goose::swap(mCtrl, other.mCtrl);
+                    goose::swap(mSlots, other.mSlots);
+                    goose::swap(mCapacity, other.mCapacity);
+                    goose::swap(mSize, other.mSize);
+                    goose::swap(mGrowthLeft, other.mGrowthLeft);
+                    std::swap(mHash, other.mHash);
+                    std::swap(mEqual, other.mEqual);
+                    std::swap(mAlloc, other.mAlloc);
+                }
+            public:
+                template<typename K>
+                iterator find(const K& key) {
+                    size_t index = findIndex(static_cast<const _lookupKey<K>&>(key));
+                    return index == npos ? end() : iteratorAt(index);
+                }
+
+                template<typename K>
+                constIterator find(const K& key) const {
+                    size_t index = findIndex(static_cast<const _lookupKey<K>&>(key));
+                    return index == npos ? cend() : constIterator{mCtrl + index, mCtrl + mCapacity, mSlots + index};
+                }
+
+                template<typename K>
+                bool contains(const K& key) const { return findIndex(static_cast<const _lookupKey<K>&>(key)) != npos; }
+
+                template<typename K>
+                sizeType count(const K& key) const { return contains(key) ? 1 : 0; }
+
+                // Finds key, or constructs a new slot from args when it is missing. args are only
+                // used when the insert happens.
+                template<typename K, typename... Args>
+                std::pair<iterator, bool> findOrEmplace(const K& key, Args&&... args) {
+                    uint64_t hash = hashOf(key);
+                    size_t index = findIndex(key, hash);
+                    if (index != npos) return {iteratorAt(index), false};
+                    return {iteratorAt(insertUnique(hash, std::forward<Args>(args)...)), true};
+                }
+
+                template<typename K>
+                sizeType eraseKey(const K& key) {
+                    size_t index = findIndex(static_cast<const _lookupKey<K>&>(key));
+                    if (index == npos) return 0;
+                    eraseAt(index);
+                    return 1;
+                }
+
+                iterator erase(constIterator pos) {
+                    size_t index = pos.mCtrl - mCtrl;
+                    eraseAt(index);
+                    return iteratorAt(index + 1);
+                }
+            private:
+                static constexpr size_t maxLoad(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+                static size_t capacityFor(size_t count) noexcept {
+                    size_t capacity = groupWidth;
+                    while (maxLoad(capacity) < count) capacity *= 2;
+                    return capacity;
+                }
+
+                template<typename K>
+                uint64_t hashOf(const K& key) const {
+                    return _mixHash(static_cast<uint64_t>(mHash(key)));
+                }
+
+                static int8_t h2(uint64_t hash) noexcept { return static_cast<int8_t>(hash & 0x7F); }
+
+                iterator iteratorAt(size_t index) noexcept { return {mCtrl + index, mCtrl + mCapacity, mSlots + index}; }
+
+                void setCtrl(size_t index, int8_t value) noexcept {
+                    mCtrl[index] = value;
+                    if (index < groupWidth) mCtrl[mCapacity + index] = value;
+                }
+
+                template<typename K>
+                size_t findIndex(const K& key) const { return mCapacity ? findIndex(key, hashOf(key)) : npos; }
+
+                // Walks groups with triangular steps, which visits every group of a power-of-two table.
+                template<typename K>
+                size_t findIndex(const K& key, uint64_t hash) const {
+                    if (!mCapacity) return npos;
+                    size_t mask = mCapacity - 1;
+                    size_t pos = (hash >> 7) & mask;
+                    for (size_t step = groupWidth;; step += groupWidth) {
+                        _probeGroup group(mCtrl + pos);
+                        for (uint32_t bits = group.match(h2(hash)); bits; bits &= bits - 1) {
+                            size_t index = (pos + __builtin_ctz(bits)) & mask;
+                            if (mEqual(Policy::key(Policy::element(mSlots[index])), key)) return index;
+                        }
+                        if (group.matchEmpty()) return npos;
+                        pos = (pos + step) & mask;
+                    }
+                }
+
+                size_t findInsertSlot(uint64_t hash) const noexcept {
+                    size_t mask = mCapacity - 1;
+                    size_t pos = (hash >> 7) & mask;
+                    for (size_t step = groupWidth;; step += groupWidth) {
+                        uint32_t bits = _probeGroup(mCtrl + pos).matchEmptyOrDeleted();
+                        if (bits) return (pos + __builtin_ctz(bits)) & mask;
+                        pos = (pos + step) & mask;
+                    }
+                }
+
+                // Expects the key to be absent.
+                template<typename... Args>
+                size_t insertUnique(uint64_t hash, Args&&... args) {
+                    if (!mCapacity) resize(groupWidth);
+                    size_t index = findInsertSlot(hash);
+                    if (mGrowthLeft == 0 && mCtrl[index] == _ctrlEmpty) {
+                        // Tombstones eat into the load budget; if they make up a large part of it,
+                        // rebuilding at the same size is enough to reclaim the space.
+                        resize(mSize * 2 < maxLoad(mCapacity) ? mCapacity : mCapacity * 2);
+                        index = findInsertSlot(hash);
+                    }
+                    valueTraits::construct(mAlloc, &Policy::element(mSlots[index]), std::forward<Args>(args)...);
+                    if (mCtrl[index] == _ctrlEmpty) --mGrowthLeft;
+                    setCtrl(index, h2(hash));
+                    ++mSize;
+                    return index;
+                }
+
+                void eraseAt(size_t index) {
+                    destroySlot(mSlots + index);
+                    setCtrl(index, _ctrlDeleted);
+                    --mSize;
+                }
+
+                void destroySlot(slotType* slot) noexcept { valueTraits::destroy(mAlloc, &Policy::element(*slot)); }
+
+                void resize(size_t newCapacity) {
+                    int8_t* oldCtrl = mCtrl;
+                    slotType* oldSlots = mSlots;
+                    size_t oldCapacity = mCapacity;
+                    size_t oldGrowthLeft = mGrowthLeft;
+
+                    ctrlAlloc ctrlAllocator(mAlloc);
+                    slotAlloc slotAllocator(mAlloc);
+                    mCtrl = ctrlTraits::allocate(ctrlAllocator, newCapacity + groupWidth);
+                    try {
+                        mSlots = slotTraits::allocate(slotAllocator, newCapacity);
+                    } catch (...) {
+                        ctrlTraits::deallocate(ctrlAllocator, mCtrl, newCapacity + groupWidth);
+                        mCtrl = oldCtrl;
+                        throw;
+                    }
+                    std::memset(mCtrl, static_cast<unsigned char>(_ctrlEmpty), newCapacity + groupWidth);
+                    mCapacity = newCapacity;
+                    mGrowthLeft = maxLoad(newCapacity) - mSize;
+
+                    try {
+                        for (size_t i = 0; i < oldCapacity; ++i) {
+                            if (oldCtrl[i] < 0) continue;
+                            uint64_t hash = hashOf(Policy::key(Policy::element(oldSlots[i])));
+                            size_t index = findInsertSlot(hash);
+                            if constexpr (moveOnRehash) {
+                                Policy::transfer(mAlloc, mSlots + index, oldSlots + i);
+                            } else {
+                                valueTraits::construct(mAlloc, &Policy::element(mSlots[index]), Policy::element(oldSlots[i]));
+                            }
+                            setCtrl(index, h2(hash));
+                        }
+                    } catch (...) {
+                        for (size_t i = 0; i < newCapacity; ++i) {
+                            if (mCtrl[i] >= 0) destroySlot(mSlots + i);
+                        }
+                        ctrlTraits::deallocate(ctrlAllocator, mCtrl, newCapacity + groupWidth);
+                        slotTraits::deallocate(slotAllocator, mSlots, newCapacity);
+                        mCtrl = oldCtrl;
+                        mSlots = oldSlots;
+                        mCapacity = oldCapacity;
+                        mGrowthLeft = oldGrowthLeft;
+                        throw;
+                    }
+
+                    if (oldCapacity) {
+                        if constexpr (!std::is_trivially_destructible_v<valueType>) {
+                            for (size_t i = 0; i < oldCapacity; ++i) {
+                                if (oldCtrl[i] >= 0) destroySlot(oldSlots + i);
+                            }
+                        }
+                        ctrlTraits::deallocate(ctrlAllocator, oldCtrl, oldCapacity + groupWidth);
+                        slotTraits::deallocate(slotAllocator, oldSlots, oldCapacity);
+                    }
+                }
+
+                void destroyAll() noexcept {
+                    if (!mCapacity) return;
+                    clear();
+                    ctrlAlloc ctrlAllocator(mAlloc);
+                    slotAlloc slotAllocator(mAlloc);
+                    ctrlTraits::deallocate(ctrlAllocator, mCtrl, mCapacity + groupWidth);
+                    slotTraits::deallocate(slotAllocator, mSlots, mCapacity);
+                    mCtrl = nullptr;
+                    mSlots = nullptr;
+                    mCapacity = 0;
+                    mGrowthLeft = 0;
+                }
+            private:
+                int8_t* mCtrl{nullptr};
+                slotType* mSlots{nullptr};
+                size_t mCapacity{0};
+                size_t mSize{0};
+                size_t mGrowthLeft{0};
+                Hash mHash;
+                KeyEqual mEqual;
+                Alloc mAlloc;
+        };
+    }
+
+    // Open-addressing hash map in the style of SwissTable: a control byte per slot is probed 16
+    // at a time, and entries live inline in one slot array. Lookup is heterogeneous when both
+    // Hash and KeyEqual declare is_transparent. References are invalidated by rehashing.
+    template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Alloc = allocator<std::pair<const Key, Value>>>
+    struct flatHashMap : private _implementation::_rawHashTable<_implementation::_mapPolicy<Key, Value>, Hash, KeyEqual, Alloc> {
+        private:
+            using base = _implementation::_rawHashTable<_implementation::_mapPolicy<Key, Value>, Hash, KeyEqual, Alloc>;
+        public:
+            using keyType = Key;
+            using mappedType = Value;
+            using valueType = std::pair<const Key, Value>;
+            using sizeType = size_t;
+            using hasher = Hash;
+            using keyEqual = KeyEqual;
+            using allocatorType = Alloc;
+            using iterator = typename base::iterator;
+            using constIterator = typename base::constIterator;
+        public:
+            flatHashMap() = default;
+            explicit flatHashMap(sizeType bucketCount, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+                                 const Alloc& alloc = Alloc())
+                : base(bucketCount, hash, equal, alloc) {}
+            flatHashMap(std::initializer_list<valueType> list) : base(list.size()) {
+                for (const auto& value : list) insert(value);
+            }
+        public:
+            using base::begin;
+            using base::end;
+            using base::cbegin;
+            using base::cend;
+            using base::size;
+            using base::empty;
+            using base::capacity;
+            using base::loadFactor;
+            using base::reserve;
+            using base::clear;
+            using base::find;
+            using base::contains;
+            using base::count;
+
+            void swap(flatHashMap& other) noexcept { base::swap(other); }
+
+            std::pair<iterator, bool> insert(const valueType& value) { return this->findOrEmplace(value.first, value); }
+            std::pair<iterator, bool> insert(valueType&& value) { return this->findOrEmplace(value.first, std::move(value)); }
+
+            template<typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args) {
+                valueType value(std::forward<Args>(args)...);
+                return this->findOrEmplace(value.first, std::move(value));
+            }
+
+            template<typename... Args>
+            std::pair<iterator, bool> tryEmplace(const Key& key, Args&&... args) {
+                return this->findOrEmplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                           std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            template<typename... Args>
+            std::pair<iterator, bool> tryEmplace(Key&& key, Args&&... args) {
+                return this->findOrEmplace(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                           std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            template<typename V>
+            std::pair<iterator, bool> insertOrAssign(const Key& key, V&& value) {
+                auto result = tryEmplace(key, std::forward<V>(value));
+                if (!result.second) result.first->second = std::forward<V>(value);
+                return result;
+            }
+
+            Value& operator[](const Key& key) { return tryEmplace(key).first->second; }
+            Value& operator[](Key&& key) { return tryEmplace(std::move(key)).first->second; }
+
+            iterator erase(iterator pos) { return base::erase(pos); }
+            iterator erase(constIterator pos) { return base::erase(pos); }
+
+            template<typename K, typename = enableIfT<!std::is_convertible_v<const K&, constIterator>>>
+            sizeType erase(const K& key) { return this->eraseKey(key); }
+    };
+
+    template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Alloc = allocator<Key>>
+    struct flatHashSet : private _implementation::_rawHashTable<_implementation::_setPolicy<Key>, Hash, KeyEqual, Alloc> {
+        private:
+            using base = _implementation::_rawHashTable<_implementation::_setPolicy<Key>, Hash, KeyEqual, Alloc>;
+        public:
+            using keyType = Key;
+            using valueType = Key;
+            using sizeType = size_t;
+            using hasher = Hash;
+            using keyEqual = KeyEqual;
+            using allocatorType = Alloc;
+            // Keys must not change while stored, so both iterators are read-only.
+            using iterator = typename base::constIterator;
+            using constIterator = typename base::constIterator;
+        public:
+            flatHashSet() = default;
+            explicit flatHashSet(sizeType bucketCount, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+                                 const Alloc& alloc = Alloc())
+                : base(bucketCount, hash, equal, alloc) {}
+            flatHashSet(std::initializer_list<Key> list) : base(list.size()) {
+                for (const auto& key : list) insert(key);
+            }
+        public:
+            constIterator begin() const noexcept { return base::cbegin(); }
+            constIterator end() const noexcept { return base::cend(); }
+            using base::cbegin;
+            using base::cend;
+            using base::size;
+            using base::empty;
+            using base::capacity;
+            using base::loadFactor;
+            using base::reserve;
+            using base::clear;
+            using base::contains;
+            using base::count;
+
+            void swap(flatHashSet& other) noexcept { base::swap(other); }
+
+            template<typename K>
+            constIterator find(const K& key) const { return base::find(key); }
+
+            std::pair<constIterator, bool> insert(const Key& key) {
+                auto result = this->findOrEmplace(key, key);
+                return {result.first, result.second};
+            }
+
+            std::pair<constIterator, bool> insert(Key&& key) {
+                auto result = this->findOrEmplace(key, std::move(key));
+                return {result.first, result.second};
+            }
+
+            template<typename... Args>
+            std::pair<constIterator, bool> emplace(Args&&... args) {
+                return insert(Key(std::forward<Args>(args)...));
+            }
+
+            constIterator erase(constIterator pos) { return base::erase(pos); }
+
+            template<typename K, typename = enableIfT<!std::is_convertible_v<const K&, constIterator>>>
+            sizeType erase(const K& key) { return this->eraseKey(key); }
+    };
+}
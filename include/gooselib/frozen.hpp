@@ -0,0 +1,257 @@
+#pragma once
+
+#include "array.hpp"
+#include "sort.hpp"
+#include "type_traits.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace goose {
+    template<typename K, typename V>
+    struct frozenEntry {
+        K key;
+        V value;
+    };
+
+    // Hashes integers, enums and anything with constexpr data() and size() such as
+    // std::string_view. The table mixes the result itself, so the integer hash is the identity.
+    template<typename K, typename = void>
+    struct frozenHash {
+        static_assert(std::is_integral_v<K> || std::is_enum_v<K>, "no frozenHash for this key type");
+
+        constexpr uint64_t operator()(const K& key) const noexcept { return static_cast<uint64_t>(key); }
+    };
+
+    template<typename K>
+    struct frozenHash<K, std::void_t<decltype(std::declval<const K&>().data()), decltype(std::declval<const K&>().size())>> {
+        constexpr uint64_t operator()(const K& key) const noexcept {
+            uint64_t hash = 0xCBF29CE484222325ull;
+            auto data = key.data();
+            for (size_t i = 0, size = key.size(); i < size; ++i) {
+                hash ^= static_cast<unsigned char>(data[i]);
+                hash *= 0x100000001B3ull;
+            }
+            return hash;
+        }
+    };
+
+    namespace _implementation {
+        constexpr size_t _frozenPow2(size_t n) noexcept {
+            size_t result = 1;
+            while (result < n) result *= 2;
+            return result;
+        }
+
+        constexpr unsigned _frozenLog2(size_t n) noexcept {
+            unsigned result = 0;
+            while ((size_t{1} << result) < n) ++result;
+            return result;
+        }
+
+        // Hash-and-displace perfect hash over N precomputed hashes. Keys are spread over about N/2
+        // buckets, and each bucket gets the smallest displacement that sends all of its keys to
+        // free slots, fullest buckets first. A lookup is then one bucket read and one slot read,
+        // with no probing. Slots hold an entry index, or N when empty. sameKey(i, j) compares the
+        // keys behind two equal hashes, since the index itself could not tell them apart.
+        template<size_t N>
+        struct _frozenIndex {
+            static_assert(N > 0, "a frozen table needs at least one key");
+            static_assert(N < UINT32_MAX, "too many keys for a frozen table");
+            public:
+                static constexpr size_t bucketCount = _frozenPow2(N / 2);
+                static constexpr size_t slotCount = _frozenPow2(N + N / 4);
+            public:
+                template<typename SameKey>
+                constexpr _frozenIndex(const goose::array<uint64_t, N>& hashes, const SameKey& sameKey) {
+                    for (size_t i = 0; i < slotCount; ++i) mSlots[i] = N;
+
+                    // Counting sort of the keys by bucket.
+                    goose::array<uint32_t, bucketCount + 1> start{};
+                    for (size_t i = 0; i < N; ++i) ++start[bucketOf(hashes[i]) + 1];
+                    for (size_t b = 0; b < bucketCount; ++b) start[b + 1] += start[b];
+                    goose::array<uint32_t, N> members{};
+                    goose::array<uint32_t, bucketCount> fill{};
+                    for (size_t i = 0; i < N; ++i) {
+                        size_t bucket = bucketOf(hashes[i]);
+                        members[start[bucket] + fill[bucket]++] = static_cast<uint32_t>(i);
+                    }
+
+                    goose::array<_bucketSize, bucketCount> order{};
+                    for (size_t b = 0; b < bucketCount; ++b) order[b] = {fill[b], static_cast<uint32_t>(b)};
+                    goose::sort(order.begin(), order.end(), [](const _bucketSize& a, const _bucketSize& b) {
+                        return a.size > b.size;
+                    });
+
+                    for (size_t k = 0; k < bucketCount && order[k].size > 0; ++k) {
+                        size_t bucket = order[k].bucket;
+                        size_t first = start[bucket];
+                        size_t last = first + order[k].size;
+                        for (size_t i = first; i < last; ++i) {
+                            for (size_t j = first; j < i; ++j) {
+                                if (hashes[members[i]] != hashes[members[j]]) continue;
+                                if (sameKey(members[i], members[j])) throw std::logic_error("frozen table keys must be unique");
+                                throw std::logic_error("frozen table keys have colliding hashes; use another Hash");
+                            }
+                        }
+                        uint32_t seed = 1;
+                        while (!fits(hashes, members, first, last, seed)) {
+                            if (++seed == 0) throw std::logic_error("no perfect hash for these frozen table keys");
+                        }
+                        mSeeds[bucket] = seed;
+                        for (size_t i = first; i < last; ++i) mSlots[slotOf(hashes[members[i]], seed)] = members[i];
+                    }
+                }
+            public:
+                // The only entry that can hold a key with this hash, or N.
+                constexpr size_t find(uint64_t hash) const noexcept {
+                    return mSlots[slotOf(hash, mSeeds[bucketOf(hash)])];
+                }
+            private:
+                static constexpr unsigned bucketShift = 64 - _frozenLog2(bucketCount);
+                static constexpr unsigned slotShift = 64 - _frozenLog2(slotCount);
+
+                struct _bucketSize {
+                    uint32_t size;
+                    uint32_t bucket;
+                };
+
+                // Multiply-shift on both levels: one multiply each, and the high bits it keeps are
+                // well mixed even when the key hash is an integer's identity.
+                static constexpr size_t bucketOf(uint64_t hash) noexcept {
+                    if constexpr (bucketCount == 1) return 0;
+                    else return (hash * 0x9E3779B97F4A7C15ull) >> bucketShift;
+                }
+
+                static constexpr size_t slotOf(uint64_t hash, uint32_t seed) noexcept {
+                    if constexpr (slotCount == 1) return 0;
+                    else return ((hash ^ (seed * 0xC2B2AE3D27D4EB4Full)) * 0x9E3779B97F4A7C15ull) >> slotShift;
+                }
+
+                constexpr bool fits(const goose::array<uint64_t, N>& hashes, const goose::array<uint32_t, N>& members,
+                                    size_t first, size_t last, uint32_t seed) const noexcept {
+                    for (size_t i = first; i < last; ++i) {
+                        size_t slot = slotOf(hashes[members[i]], seed);
+                        if (mSlots[slot] != N) return false;
+                        for (size_t j = first; j < i; ++j) {
+                            if (slotOf(hashes[members[j]], seed) == slot) return false;
+                        }
+                    }
+                    return true;
+                }
+
+                goose::array<uint32_t, bucketCount> mSeeds{};
+                goose::array<uint32_t, slotCount> mSlots{};
+        };
+
+        template<typename Hash, typename K, size_t N, typename GetKey, size_t... I>
+        constexpr goose::array<uint64_t, N> _frozenHashes(const Hash& hash, const GetKey& getKey, std::index_sequence<I...>) {
+            return {{hash(getKey(I))...}};
+        }
+    }
+
+    // Read-only map whose layout is computed at compile time: declare it constexpr (see
+    // makeFrozenMap) and lookups touch two small arrays and compare one key, with nothing built
+    // at startup. Entries keep the order they were given in. Duplicate keys fail to compile, and
+    // so do distinct keys whose 64-bit hashes collide, with a separate message.
+    template<typename K, typename V, size_t N, typename Hash = frozenHash<K>, typename KeyEqual = std::equal_to<K>>
+    struct frozenMap {
+        public:
+            using keyType = K;
+            using mappedType = V;
+            using valueType = frozenEntry<K, V>;
+            using sizeType = size_t;
+            using constIterator = const valueType*;
+            using iterator = constIterator;
+        public:
+            constexpr frozenMap(const valueType (&entries)[N], const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+                : frozenMap(entries, hash, equal, std::make_index_sequence<N>{}) {}
+        public:
+            constexpr constIterator find(const K& key) const {
+                size_t index = mIndex.find(mHash(key));
+                return index != N && mEqual(mEntries[index].key, key) ? &mEntries[index] : end();
+            }
+
+            constexpr bool contains(const K& key) const { return find(key) != end(); }
+            constexpr sizeType count(const K& key) const { return contains(key) ? 1 : 0; }
+
+            // Throws std::out_of_range when the key is missing.
+            constexpr const V& at(const K& key) const {
+                constIterator it = find(key);
+                if (it == end()) throw std::out_of_range("frozenMap::at");
+                return it->value;
+            }
+
+            constexpr sizeType size() const noexcept { return N; }
+            constexpr bool empty() const noexcept { return false; }
+
+            constexpr constIterator begin() const noexcept { return &mEntries[0]; }
+            constexpr constIterator end() const noexcept { return &mEntries[0] + N; }
+        private:
+            template<size_t... I>
+            constexpr frozenMap(const valueType (&entries)[N], const Hash& hash, const KeyEqual& equal, std::index_sequence<I...> seq)
+                : mEntries{{entries[I]...}},
+                  mIndex(_implementation::_frozenHashes<Hash, K, N>(hash, [&](size_t i) -> const K& { return entries[i].key; }, seq),
+                         [&](size_t a, size_t b) { return equal(entries[a].key, entries[b].key); }),
+                  mHash{hash}, mEqual{equal} {}
+
+            goose::array<valueType, N> mEntries;
+            _implementation::_frozenIndex<N> mIndex;
+            Hash mHash;
+            KeyEqual mEqual;
+    };
+
+    // The set counterpart of frozenMap.
+    template<typename K, size_t N, typename Hash = frozenHash<K>, typename KeyEqual = std::equal_to<K>>
+    struct frozenSet {
+        public:
+            using keyType = K;
+            using valueType = K;
+            using sizeType = size_t;
+            using constIterator = const K*;
+            using iterator = constIterator;
+        public:
+            constexpr frozenSet(const K (&keys)[N], const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+                : frozenSet(keys, hash, equal, std::make_index_sequence<N>{}) {}
+        public:
+            constexpr constIterator find(const K& key) const {
+                size_t index = mIndex.find(mHash(key));
+                return index != N && mEqual(mKeys[index], key) ? &mKeys[index] : end();
+            }
+
+            constexpr bool contains(const K& key) const { return find(key) != end(); }
+            constexpr sizeType count(const K& key) const { return contains(key) ? 1 : 0; }
+
+            constexpr sizeType size() const noexcept { return N; }
+            constexpr bool empty() const noexcept { return false; }
+
+            constexpr constIterator begin() const noexcept { return &mKeys[0]; }
+            constexpr constIterator end() const noexcept { return &mKeys[0] + N; }
+        private:
+            template<size_t... I>
+            constexpr frozenSet(const K (&keys)[N], const Hash& hash, const KeyEqual& equal, std::index_sequence<I...> seq)
+                : mKeys{{keys[I]...}},
+                  mIndex(_implementation::_frozenHashes<Hash, K, N>(hash, [&](size_t i) -> const K& { return keys[i]; }, seq),
+                         [&](size_t a, size_t b) { return equal(keys[a], keys[b]); }),
+                  mHash{hash}, mEqual{equal} {}
+
+            goose::array<K, N> mKeys;
+            _implementation::_frozenIndex<N> mIndex;
+            Hash mHash;
+            KeyEqual mEqual;
+    };
+
+    // constexpr auto opcodes = goose::makeFrozenMap<std::string_view, int>({{"GET", 1}, {"PUT", 2}});
+    template<typename K, typename V, size_t N>
+    constexpr frozenMap<K, V, N> makeFrozenMap(const frozenEntry<K, V> (&entries)[N]) {
+        return frozenMap<K, V, N>(entries);
+    }
+
+    template<typename K, size_t N>
+    constexpr frozenSet<K, N> makeFrozenSet(const K (&keys)[N]) {
+        return frozenSet<K, N>(keys);
+    }
+}
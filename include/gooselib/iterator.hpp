@@ -42,10 +42,10 @@ namespace goose {
     struct Range {
         public:
             Range(Begin _begin, End _end) : m_begin{_begin}, m_end{_end} {}
-            Begin begin() {
+            Begin begin() const {
                 return m_begin;
             }
-            End end() {
+            End end() const {
                 return m_end;
             }
 
@@ -64,45 +64,50 @@ namespace goose {
             using pointer = T*;
             using iteratorCategory = goose::randomAccessIteratorTag;
         public:
-            genericIterator() noexcept = default;
-            genericIterator(pointer _ptr) noexcept : mPtr{_ptr} {}
+            constexpr genericIterator() noexcept = default;
+            constexpr genericIterator(pointer _ptr) noexcept : mPtr{_ptr} {}
 
         public:
-            genericIterator& operator++() { ++mPtr; return *this; }
-            genericIterator operator++(int) {
+            constexpr genericIterator& operator++() { ++mPtr; return *this; }
+            constexpr genericIterator operator++(int) {
                 auto tmp = *this;
                 ++mPtr;
                 return tmp;
             }
 
-            genericIterator& operator+=(differenceType n) { mPtr += n; return *this; }
-            genericIterator operator+(differenceType n) const { return {mPtr + n}; }
+            constexpr genericIterator& operator+=(differenceType n) { mPtr += n; return *this; }
+            constexpr genericIterator operator+(differenceType n) const { return {mPtr + n}; }
             
-            genericIterator& operator--() { --mPtr; return *this; }
-            genericIterator operator--(int) {
+            constexpr genericIterator& operator--() { --mPtr; return *this; }
+            constexpr genericIterator operator--(int) {
                 auto tmp = *this;
                 --mPtr;
                 return tmp;
             }
 
-            genericIterator& operator-=(differenceType n) { mPtr -= n; return *this; }
-            genericIterator operator-(differenceType n) const { return {mPtr - n}; }
-            differenceType operator-(genericIterator other) const { return {mPtr - other.mPtr}; }
+            constexpr genericIterator& operator-=(differenceType n) { mPtr -= n; return *this; }
+            constexpr genericIterator operator-(differenceType n) const { return {mPtr - n}; }
+            constexpr differenceType operator-(genericIterator other) const { return {mPtr - other.mPtr}; }
 
         public:
-            friend bool operator==(genericIterator lhs, genericIterator rhs) { return lhs.mPtr == rhs.mPtr; }
+            friend constexpr bool operator==(genericIterator lhs, genericIterator rhs) { return lhs.mPtr == rhs.mPtr; }
 
-            friend bool operator!=(genericIterator lhs, genericIterator rhs) { return !(lhs == rhs); }
+            friend constexpr bool operator!=(genericIterator lhs, genericIterator rhs) { return !(lhs == rhs); }
+            friend constexpr bool operator<(genericIterator lhs, genericIterator rhs) { return lhs.mPtr < rhs.mPtr; }
+            friend constexpr bool operator>(genericIterator lhs, genericIterator rhs) { return lhs.mPtr > rhs.mPtr; }
+            friend constexpr bool operator<=(genericIterator lhs, genericIterator rhs) { return lhs.mPtr <= rhs.mPtr; }
+            friend constexpr bool operator>=(genericIterator lhs, genericIterator rhs) { return lhs.mPtr >= rhs.mPtr; }
         public:
-            T& operator*() const { return *mPtr; }
-            T* operator->() const { return mPtr; }
-            T* ptr() const { return mPtr; }
+            constexpr T& operator*() const { return *mPtr; }
+            constexpr T& operator[](differenceType n) const { return mPtr[n]; }
+            constexpr T* operator->() const { return mPtr; }
+            constexpr T* ptr() const { return mPtr; }
         private:            
-        T* mPtr;
+        T* mPtr{nullptr};
     };
 
     template<typename T, typename _Container>
-    genericIterator<T, _Container> operator+(typename iteratorTraits<genericIterator<T, _Container>>::difference_type n, 
+    constexpr genericIterator<T, _Container> operator+(typename iteratorTraits<genericIterator<T, _Container>>::differenceType n, 
                                              genericIterator<T, _Container> it) {
         return it + n;
     }
@@ -214,10 +219,9 @@ namespace goose {
             Iter m_iter;
     };
     template<class It>
-    typename iteratorTraits<It>::differenceType
+    constexpr typename iteratorTraits<It>::differenceType
     distance(It first, It last) {
         using category = typename iteratorTraits<It>::iteratorCategory;
-        static_assert(std::is_same_v<randomAccessIteratorTag, category>);
     
         if constexpr (std::is_base_of_v<randomAccessIteratorTag, category>)
             return last - first;
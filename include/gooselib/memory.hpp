@@ -2,11 +2,19 @@
 
 #include "type_traits.hpp"
 #include "utility.hpp"
+#include "array.hpp"
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <numeric>
 #include <type_traits>
 #include <utility>
 #include <new>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 namespace goose {
     namespace _implementation {
         template<typename _Tp>
@@ -38,6 +46,9 @@ namespace goose {
         ptr->~T();
     }
 
+    // Distance that keeps data written by different threads from sharing a cache line.
+    inline constexpr size_t cacheLineSize = 64;
+
     template<typename Ptr>
     struct pointerTraits {
         private:
@@ -72,19 +83,482 @@ namespace goose {
     struct allocator {
         public:
             using valueType = T;
+            using propagateOnContainerMoveAssignment = trueType;
+            using isAlwaysEqual = trueType;
         public:
             constexpr allocator() = default;
             constexpr allocator(const allocator&) = default;
             constexpr allocator(allocator&&) = default;
+            template<typename U>
+            constexpr allocator(const allocator<U>&) noexcept {}
+            constexpr allocator& operator=(const allocator&) = default;
+            constexpr allocator& operator=(allocator&&) = default;
         public:
             friend bool operator==(const allocator& lhs, const allocator& rhs) { return true; }
             friend bool operator!=(const allocator& lhs, const allocator& rhs) { return false; }
         public:
-            T* allocate(size_t bufSize) { return reinterpret_cast<T*>(new char[sizeof(T) * bufSize]); }
+            // Over-aligned types go through aligned operator new; the rest use the plain form so
+            // the common case keeps malloc's fast path. Deallocation passes the size back.
+            T* allocate(size_t bufSize) {
+                if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                    return static_cast<T*>(::operator new(sizeof(T) * bufSize, std::align_val_t{alignof(T)}));
+                } else {
+                    return static_cast<T*>(::operator new(sizeof(T) * bufSize));
+                }
+            }
+
+            void deallocate(T* allocated, size_t allocatedSize) noexcept {
+                if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                    ::operator delete(static_cast<void*>(allocated), sizeof(T) * allocatedSize, std::align_val_t{alignof(T)});
+                } else {
+                    ::operator delete(static_cast<void*>(allocated), sizeof(T) * allocatedSize);
+                }
+            }
+    };
+
+    // Allocates every buffer on an Align-byte boundary (or alignof(T), if that is larger), e.g.
+    // 32 or 64 for AVX loads. With PadCapacity, containers also keep their capacity a whole
+    // number of Align-byte blocks, so SIMD loops can run past size() to the end of the last block
+    // instead of finishing with a scalar tail. Those trailing lanes hold unconstructed elements.
+    template<typename T, size_t Align, bool PadCapacity = false>
+    struct alignedAllocator {
+        static_assert(Align != 0 && (Align & (Align - 1)) == 0, "alignment must be a power of two");
+        public:
+            using valueType = T;
+            using propagateOnContainerMoveAssignment = trueType;
+            using isAlwaysEqual = trueType;
+            using padCapacity = boolConstant<PadCapacity>;
+            template<typename U>
+            using rebind = alignedAllocator<U, Align, PadCapacity>;
+
+            static constexpr size_t alignment = Align > alignof(T) ? Align : alignof(T);
+        public:
+            constexpr alignedAllocator() noexcept = default;
+            template<typename U>
+            constexpr alignedAllocator(const alignedAllocator<U, Align, PadCapacity>&) noexcept {}
+        public:
+            friend bool operator==(const alignedAllocator&, const alignedAllocator&) { return true; }
+            friend bool operator!=(const alignedAllocator&, const alignedAllocator&) { return false; }
+        public:
+            T* allocate(size_t bufSize) {
+                return static_cast<T*>(::operator new(sizeof(T) * bufSize, std::align_val_t{alignment}));
+            }
+
+            void deallocate(T* allocated, size_t allocatedSize) noexcept {
+                ::operator delete(static_cast<void*>(allocated), sizeof(T) * allocatedSize, std::align_val_t{alignment});
+            }
+    };
+
+    // Aligned to a full cache line, which covers every x86 vector width, with padded capacity.
+    template<typename T, size_t Align = 64>
+    using simdAllocator = alignedAllocator<T, Align, true>;
+
+    // Bump allocator backing arenaAllocator. Serves requests from an optional caller-provided
+    // buffer first, then from heap blocks that grow geometrically. Nothing is returned to the
+    // heap until release() or destruction, at which point everything is dropped at once.
+    struct arena {
+        private:
+            static constexpr size_t growthFactor = 2;
+            static constexpr size_t defaultBlockSize = 1024;
+
+            struct blockHeader {
+                blockHeader* next;
+                size_t size;
+            };
+        public:
+            arena() noexcept = default;
+            explicit arena(size_t initialBlockSize) noexcept : mNextBlockSize{initialBlockSize ? initialBlockSize : defaultBlockSize} {}
+            arena(void* buffer, size_t bufferSize) noexcept
+                : mInitialBuffer{static_cast<std::byte*>(buffer)}, mInitialSize{bufferSize},
+                  mCurrent{mInitialBuffer}, mEnd{mInitialBuffer + bufferSize},
+                  mNextBlockSize{bufferSize ? bufferSize * growthFactor : defaultBlockSize} {}
+
+            arena(const arena&) = delete;
+            arena& operator=(const arena&) = delete;
+
+            ~arena() { release(); }
+        public:
+            void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+                void* result = bump(bytes, align);
+                if (!result) {
+                    addBlock(bytes + align);
+                    result = bump(bytes, align);
+                }
+                return result;
+            }
+
+            void deallocate(void*, size_t, size_t = alignof(std::max_align_t)) noexcept {}
+
+            // Frees every heap block and rewinds to the start of the initial buffer.
+            void release() noexcept {
+                while (mBlocks) {
+                    blockHeader* next = mBlocks->next;
+                    ::operator delete(static_cast<void*>(mBlocks));
+                    mBlocks = next;
+                }
+                mCurrent = mInitialBuffer;
+                mEnd = mInitialBuffer + mInitialSize;
+                mNextBlockSize = mInitialSize ? mInitialSize * growthFactor : defaultBlockSize;
+            }
+
+            size_t remaining() const noexcept { return mEnd - mCurrent; }
+        private:
+            void* bump(size_t bytes, size_t align) noexcept {
+                if (!mCurrent) return nullptr;
+                uintptr_t address = reinterpret_cast<uintptr_t>(mCurrent);
+                size_t padding = (align - (address & (align - 1))) & (align - 1);
+                if (padding + bytes > static_cast<size_t>(mEnd - mCurrent)) return nullptr;
+                std::byte* result = mCurrent + padding;
+                mCurrent = result + bytes;
+                return result;
+            }
+
+            void addBlock(size_t minimumBytes) {
+                size_t size = mNextBlockSize;
+                while (size < minimumBytes) size *= growthFactor;
+                auto* block = static_cast<blockHeader*>(::operator new(sizeof(blockHeader) + size));
+                block->next = mBlocks;
+                block->size = size;
+                mBlocks = block;
+                mCurrent = reinterpret_cast<std::byte*>(block + 1);
+                mEnd = mCurrent + size;
+                mNextBlockSize = size * growthFactor;
+            }
+        private:
+            std::byte* mInitialBuffer{nullptr};
+            size_t mInitialSize{0};
+            std::byte* mCurrent{nullptr};
+            std::byte* mEnd{nullptr};
+            blockHeader* mBlocks{nullptr};
+            size_t mNextBlockSize{defaultBlockSize};
+    };
+
+    template<typename T>
+    struct arenaAllocator {
+        public:
+            using valueType = T;
+            template<typename U>
+            using rebind = arenaAllocator<U>;
+        public:
+            arenaAllocator(arena& source) noexcept : mArena{&source} {}
+            template<typename U>
+            arenaAllocator(const arenaAllocator<U>& other) noexcept : mArena{other.source()} {}
+        public:
+            friend bool operator==(const arenaAllocator& lhs, const arenaAllocator& rhs) { return lhs.mArena == rhs.mArena; }
+            friend bool operator!=(const arenaAllocator& lhs, const arenaAllocator& rhs) { return lhs.mArena != rhs.mArena; }
+        public:
+            T* allocate(size_t bufSize) { return static_cast<T*>(mArena->allocate(sizeof(T) * bufSize, alignof(T))); }
+            void deallocate(T*, size_t) noexcept {}
+
+            arena* source() const noexcept { return mArena; }
+        private:
+            arena* mArena;
+    };
+
+    // Fixed-size slot pool. Slots are carved out of slabs of slotsPerSlab and recycled through
+    // an intrusive free list threaded through the unused slots themselves.
+    struct objectPool {
+        private:
+            struct freeSlot {
+                freeSlot* next;
+            };
+            struct slabHeader {
+                slabHeader* next;
+            };
+        public:
+            objectPool(size_t slotSize, size_t slotAlign, size_t slotsPerSlab = 256) noexcept
+                : mSlotAlign{slotAlign < alignof(freeSlot) ? alignof(freeSlot) : slotAlign},
+                  mSlotSize{roundUp(slotSize < sizeof(freeSlot) ? sizeof(freeSlot) : slotSize, mSlotAlign)},
+                  mSlotsPerSlab{slotsPerSlab ? slotsPerSlab : 1} {}
+
+            objectPool(const objectPool&) = delete;
+            objectPool& operator=(const objectPool&) = delete;
+
+            ~objectPool() {
+                while (mSlabs) {
+                    slabHeader* next = mSlabs->next;
+                    ::operator delete(static_cast<void*>(mSlabs), std::align_val_t{mSlotAlign});
+                    mSlabs = next;
+                }
+            }
+        public:
+            void* allocate() {
+                if (!mFree) addSlab();
+                freeSlot* slot = mFree;
+                mFree = slot->next;
+                ++mInUse;
+                return slot;
+            }
+
+            void deallocate(void* ptr) noexcept {
+                auto* slot = static_cast<freeSlot*>(ptr);
+                slot->next = mFree;
+                mFree = slot;
+                --mInUse;
+            }
+
+            size_t slotSize() const noexcept { return mSlotSize; }
+            size_t inUse() const noexcept { return mInUse; }
+            size_t capacity() const noexcept { return mCapacity; }
+        private:
+            static constexpr size_t roundUp(size_t value, size_t align) noexcept {
+                return (value + align - 1) & ~(align - 1);
+            }
+
+            void addSlab() {
+                size_t headerSize = roundUp(sizeof(slabHeader), mSlotAlign);
+                void* memory = ::operator new(headerSize + mSlotSize * mSlotsPerSlab, std::align_val_t{mSlotAlign});
+                auto* slab = static_cast<slabHeader*>(memory);
+                slab->next = mSlabs;
+                mSlabs = slab;
 
-            void deallocate(T* allocated, size_t allocatedSize) {
-                delete[] allocated;
+                // Thread the free list front to back so fresh slots are handed out in address order.
+                std::byte* first = static_cast<std::byte*>(memory) + headerSize;
+                for (size_t i = mSlotsPerSlab; i > 0; --i) {
+                    auto* slot = reinterpret_cast<freeSlot*>(first + (i - 1) * mSlotSize);
+                    slot->next = mFree;
+                    mFree = slot;
+                }
+                mCapacity += mSlotsPerSlab;
             }
+        private:
+            size_t mSlotAlign;
+            size_t mSlotSize;
+            size_t mSlotsPerSlab;
+            freeSlot* mFree{nullptr};
+            slabHeader* mSlabs{nullptr};
+            size_t mInUse{0};
+            size_t mCapacity{0};
+    };
+
+    namespace _implementation {
+        // The pools behind one poolAllocator, its copies and its rebinds: one objectPool per slot
+        // size and alignment, created on first use. The reference count is atomic, but the pools
+        // are not, so allocators sharing them must allocate from one thread at a time.
+        struct _sharedPools {
+            private:
+                struct entry {
+                    entry(size_t slotSize, size_t slotAlign, size_t slotsPerSlab, entry* nextEntry) noexcept
+                        : size{slotSize}, align{slotAlign}, pool(slotSize, slotAlign, slotsPerSlab), next{nextEntry} {}
+
+                    size_t size;
+                    size_t align;
+                    objectPool pool;
+                    entry* next;
+                };
+            public:
+                explicit _sharedPools(size_t slotsPerSlab) noexcept : mSlotsPerSlab{slotsPerSlab} {}
+
+                _sharedPools(const _sharedPools&) = delete;
+                _sharedPools& operator=(const _sharedPools&) = delete;
+
+                ~_sharedPools() {
+                    while (mEntries) {
+                        entry* next = mEntries->next;
+                        delete mEntries;
+                        mEntries = next;
+                    }
+                }
+            public:
+                objectPool& poolFor(size_t slotSize, size_t slotAlign) {
+                    for (entry* e = mEntries; e; e = e->next) {
+                        if (e->size == slotSize && e->align == slotAlign) return e->pool;
+                    }
+                    mEntries = new entry(slotSize, slotAlign, mSlotsPerSlab, mEntries);
+                    return mEntries->pool;
+                }
+
+                void retain() noexcept { mRefCount.fetch_add(1, std::memory_order_relaxed); }
+                bool release() noexcept { return mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+            private:
+                size_t mSlotsPerSlab;
+                entry* mEntries{nullptr};
+                std::atomic<size_t> mRefCount{1};
+        };
+    }
+
+    // Single-object allocations are served from a pool shared by every copy of the allocator.
+    // Array allocations (bufSize != 1) fall through to the general heap. Rebinds share the same
+    // set of pools, with one pool per slot size, so rebound copies compare equal to the original.
+    template<typename T, size_t SlotsPerSlab = 256>
+    struct poolAllocator {
+        public:
+            using valueType = T;
+            using propagateOnContainerCopyAssignment = trueType;
+            using propagateOnContainerMoveAssignment = trueType;
+            using propagateOnContainerSwap = trueType;
+            using isAlwaysEqual = falseType;
+            template<typename U>
+            using rebind = poolAllocator<U, SlotsPerSlab>;
+        public:
+            poolAllocator() : mShared{new _implementation::_sharedPools(SlotsPerSlab)} {
+                try {
+                    mPool = &mShared->poolFor(sizeof(T), alignof(T));
+                } catch (...) {
+                    delete mShared;
+                    throw;
+                }
+            }
+            poolAllocator(const poolAllocator& other) noexcept : mShared{other.mShared}, mPool{other.mPool} { mShared->retain(); }
+            template<typename U>
+            poolAllocator(const poolAllocator<U, SlotsPerSlab>& other)
+                : mShared{other.mShared}, mPool{&other.mShared->poolFor(sizeof(T), alignof(T))} { mShared->retain(); }
+
+            poolAllocator& operator=(const poolAllocator& other) noexcept {
+                other.mShared->retain();
+                drop();
+                mShared = other.mShared;
+                mPool = other.mPool;
+                return *this;
+            }
+
+            ~poolAllocator() { drop(); }
+        public:
+            template<typename U>
+            friend bool operator==(const poolAllocator& lhs, const poolAllocator<U, SlotsPerSlab>& rhs) { return lhs.sharesPoolsWith(rhs); }
+            template<typename U>
+            friend bool operator!=(const poolAllocator& lhs, const poolAllocator<U, SlotsPerSlab>& rhs) { return !lhs.sharesPoolsWith(rhs); }
+        public:
+            T* allocate(size_t bufSize) {
+                if (bufSize == 1) return static_cast<T*>(mPool->allocate());
+                return static_cast<T*>(::operator new(sizeof(T) * bufSize, std::align_val_t{alignof(T)}));
+            }
+
+            void deallocate(T* allocated, size_t allocatedSize) noexcept {
+                if (allocatedSize == 1) {
+                    mPool->deallocate(allocated);
+                } else {
+                    ::operator delete(static_cast<void*>(allocated), std::align_val_t{alignof(T)});
+                }
+            }
+
+            size_t inUse() const noexcept { return mPool->inUse(); }
+            size_t capacity() const noexcept { return mPool->capacity(); }
+        private:
+            template<typename U>
+            bool sharesPoolsWith(const poolAllocator<U, SlotsPerSlab>& other) const noexcept { return mShared == other.mShared; }
+
+            void drop() noexcept {
+                if (mShared->release()) delete mShared;
+            }
+        private:
+            template<typename, size_t> friend struct poolAllocator;
+
+            _implementation::_sharedPools* mShared;
+            objectPool* mPool;
+    };
+
+    // Huge page size assumed for x86-64 and most aarch64 kernels.
+    inline constexpr size_t hugePageSize = size_t{2} << 20;
+
+    struct hugePageOptions {
+        // Requests of at least this many bytes are mapped; smaller ones go to operator new.
+        size_t threshold = hugePageSize;
+        // Try MAP_HUGETLB (reserved huge pages) before transparent huge pages.
+        bool hugeTLB = false;
+        // Fault every page in during allocate so later accesses never page-fault.
+        bool prefault = false;
+
+        friend bool operator==(const hugePageOptions& lhs, const hugePageOptions& rhs) {
+            return lhs.threshold == rhs.threshold && lhs.hugeTLB == rhs.hugeTLB && lhs.prefault == rhs.prefault;
+        }
+        friend bool operator!=(const hugePageOptions& lhs, const hugePageOptions& rhs) { return !(lhs == rhs); }
+    };
+
+    namespace _implementation {
+        inline size_t _hugePageRound(size_t bytes) noexcept {
+            return (bytes + hugePageSize - 1) & ~(hugePageSize - 1);
+        }
+
+#if defined(__linux__)
+        // Maps a huge-page-aligned region of bytes (already a multiple of hugePageSize). MAP_HUGETLB
+        // fails unless huge pages were reserved, so it falls back to an ordinary mapping that is
+        // over-allocated by one huge page, trimmed to alignment and marked MADV_HUGEPAGE.
+        inline void* _mapHugePages(size_t bytes, const hugePageOptions& options) {
+#if defined(MAP_HUGETLB)
+            if (options.hugeTLB) {
+                int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (options.prefault ? MAP_POPULATE : 0);
+                void* memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+                if (memory != MAP_FAILED) return memory;
+            }
+#endif
+            void* raw = ::mmap(nullptr, bytes + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) throw std::bad_alloc();
+            auto address = reinterpret_cast<uintptr_t>(raw);
+            uintptr_t aligned = (address + hugePageSize - 1) & ~(uintptr_t{hugePageSize} - 1);
+            if (aligned != address) ::munmap(raw, aligned - address);
+            if (size_t tail = hugePageSize - (aligned - address)) ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+            auto* memory = reinterpret_cast<std::byte*>(aligned);
+#if defined(MADV_HUGEPAGE)
+            ::madvise(memory, bytes, MADV_HUGEPAGE);
+#endif
+            // MAP_POPULATE here would fault in small pages before the advice applies, so pages
+            // are populated after it instead.
+            if (options.prefault) {
+#if defined(MADV_POPULATE_WRITE)
+                if (::madvise(memory, bytes, MADV_POPULATE_WRITE) == 0) return memory;
+#endif
+                for (size_t offset = 0; offset < bytes; offset += 4096) {
+                    *static_cast<volatile std::byte*>(memory + offset) = std::byte{0};
+                }
+            }
+            return memory;
+        }
+
+        inline void _unmapHugePages(void* memory, size_t bytes) noexcept {
+            ::munmap(memory, bytes);
+        }
+#endif
+    }
+
+    // Serves large requests straight from the kernel in huge-page-aligned mappings, so big
+    // vectors are backed by 2 MB pages and need far fewer TLB entries. Sizes are rounded up to
+    // a whole huge page. Requests below the threshold, and every request on systems without
+    // mmap, go to operator new. Copies and rebinds share the options; allocators compare equal
+    // when their options do, since the threshold decides how memory is returned.
+    template<typename T>
+    struct hugePageAllocator {
+        public:
+            using valueType = T;
+            using propagateOnContainerCopyAssignment = trueType;
+            using propagateOnContainerMoveAssignment = trueType;
+            using propagateOnContainerSwap = trueType;
+            using isAlwaysEqual = falseType;
+            template<typename U>
+            using rebind = hugePageAllocator<U>;
+        public:
+            hugePageAllocator() noexcept = default;
+            explicit hugePageAllocator(const hugePageOptions& options) noexcept : mOptions{options} {}
+            template<typename U>
+            hugePageAllocator(const hugePageAllocator<U>& other) noexcept : mOptions{other.options()} {}
+        public:
+            friend bool operator==(const hugePageAllocator& lhs, const hugePageAllocator& rhs) { return lhs.mOptions == rhs.mOptions; }
+            friend bool operator!=(const hugePageAllocator& lhs, const hugePageAllocator& rhs) { return lhs.mOptions != rhs.mOptions; }
+        public:
+            T* allocate(size_t bufSize) {
+                size_t bytes = sizeof(T) * bufSize;
+#if defined(__linux__)
+                if (bytes >= mOptions.threshold && bytes > 0) {
+                    return static_cast<T*>(_implementation::_mapHugePages(_implementation::_hugePageRound(bytes), mOptions));
+                }
+#endif
+                return static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+            }
+
+            void deallocate(T* allocated, size_t allocatedSize) noexcept {
+                size_t bytes = sizeof(T) * allocatedSize;
+#if defined(__linux__)
+                if (bytes >= mOptions.threshold && bytes > 0) {
+                    _implementation::_unmapHugePages(allocated, _implementation::_hugePageRound(bytes));
+                    return;
+                }
+#endif
+                ::operator delete(static_cast<void*>(allocated), std::align_val_t{alignof(T)});
+            }
+
+            const hugePageOptions& options() const noexcept { return mOptions; }
+        private:
+            hugePageOptions mOptions;
     };
 
     template<typename Alloc>
@@ -102,6 +576,23 @@ namespace goose {
             using _differenceType = typename Tp::differenceType;
             template<typename Tp>
             using _sizeType = typename Tp::sizeType;    
+            template<typename Tp>
+            using _propagateOnContainerCopyAssignment = typename Tp::propagateOnContainerCopyAssignment;
+            template<typename Tp>
+            using _propagateOnContainerMoveAssignment = typename Tp::propagateOnContainerMoveAssignment;
+            template<typename Tp>
+            using _propagateOnContainerSwap = typename Tp::propagateOnContainerSwap;
+            template<typename Tp>
+            using _isAlwaysEqual = typename Tp::isAlwaysEqual;
+            template<typename Tp>
+            using _alignment = integralConstant<size_t, Tp::alignment>;
+            template<typename Tp>
+            using _padCapacity = typename Tp::padCapacity;
+            template<typename Tp, typename Up, typename = void>
+            struct _rebindAlloc : _implementation::replace_first_arg<Tp, Up> { };
+            template<typename Tp, typename Up>
+            struct _rebindAlloc<Tp, Up, voidT<typename Tp::template rebind<Up>>>
+            { using type = typename Tp::template rebind<Up>; };
             
             template<typename Tp, typename... Args>
             struct _construct_helper {
@@ -143,6 +634,21 @@ namespace goose {
             using constVoidPointer = detectedOr<typename pointerTraits<pointer>::rebind<const void>, _constVoidPointer, Alloc>;
             using differenceType = detectedOr<typename pointerTraits<pointer>::differenceType, _differenceType, Alloc>;
             using sizeType = detectedOr<std::make_unsigned_t<differenceType>, _sizeType, Alloc>;
+            using propagateOnContainerCopyAssignment = detectedOr<falseType, _propagateOnContainerCopyAssignment, Alloc>;
+            using propagateOnContainerMoveAssignment = detectedOr<falseType, _propagateOnContainerMoveAssignment, Alloc>;
+            using propagateOnContainerSwap = detectedOr<falseType, _propagateOnContainerSwap, Alloc>;
+            using isAlwaysEqual = detectedOr<boolConstant<std::is_empty_v<Alloc>>, _isAlwaysEqual, Alloc>;
+            using padCapacity = detectedOr<falseType, _padCapacity, Alloc>;
+            // Alignment of the buffers allocate() returns.
+            static constexpr size_t alignment = detectedOr<integralConstant<size_t, alignof(valueType)>, _alignment, Alloc>::value;
+            // Containers keep capacity a multiple of this many elements: the fewest that fill a
+            // whole number of alignment-sized blocks when the allocator asks for padding, else 1.
+            static constexpr size_t capacityGranule =
+                padCapacity::value ? alignment / std::gcd(alignment, sizeof(valueType)) : 1;
+            template<typename U>
+            using rebindAlloc = typename _rebindAlloc<Alloc, U>::type;
+            template<typename U>
+            using rebindTraits = allocatorTraits<rebindAlloc<U>>;
         public:
             static pointer allocate(Alloc& alloc, sizeType size) { return alloc.allocate(size); }
             static void deallocate(Alloc& alloc, pointer ptr, sizeType size) { alloc.deallocate(ptr, size); }
@@ -161,4 +667,130 @@ namespace goose {
                 }
             }
     };
-}
\ No newline at end of file
+    struct allocationSnapshot {
+        uint64_t allocations;
+        uint64_t deallocations;
+        uint64_t bytesAllocated;
+        uint64_t liveBytes;
+        uint64_t peakBytes;
+        // histogram[i] counts allocations of [2^(i-1), 2^i) bytes; bucket 0 holds empty requests.
+        array<uint64_t, 65> histogram;
+    };
+
+    // Counters shared by every statsAllocator pointed at them. All updates are relaxed, so a
+    // snapshot taken while other threads allocate is consistent per counter but not across them.
+    struct allocationStats {
+        public:
+            allocationStats() noexcept = default;
+            allocationStats(const allocationStats&) = delete;
+            allocationStats& operator=(const allocationStats&) = delete;
+
+            static allocationStats& global() noexcept {
+                static allocationStats stats;
+                return stats;
+            }
+        public:
+            void recordAllocate(uint64_t bytes) noexcept {
+                mAllocations.fetch_add(1, std::memory_order_relaxed);
+                mBytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+                mHistogram[bucketOf(bytes)].fetch_add(1, std::memory_order_relaxed);
+                uint64_t live = mLiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                uint64_t peak = mPeakBytes.load(std::memory_order_relaxed);
+                while (live > peak && !mPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) { }
+            }
+
+            void recordDeallocate(uint64_t bytes) noexcept {
+                mDeallocations.fetch_add(1, std::memory_order_relaxed);
+                mLiveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+            }
+
+            allocationSnapshot snapshot() const noexcept {
+                allocationSnapshot result{};
+                result.allocations = mAllocations.load(std::memory_order_relaxed);
+                result.deallocations = mDeallocations.load(std::memory_order_relaxed);
+                result.bytesAllocated = mBytesAllocated.load(std::memory_order_relaxed);
+                result.liveBytes = mLiveBytes.load(std::memory_order_relaxed);
+                result.peakBytes = mPeakBytes.load(std::memory_order_relaxed);
+                for (size_t i = 0; i < result.histogram.size(); ++i) {
+                    result.histogram[i] = mHistogram[i].load(std::memory_order_relaxed);
+                }
+                return result;
+            }
+
+            // Zeroes everything except live bytes, which still describe outstanding memory; the
+            // peak restarts from the current live total.
+            void reset() noexcept {
+                mAllocations.store(0, std::memory_order_relaxed);
+                mDeallocations.store(0, std::memory_order_relaxed);
+                mBytesAllocated.store(0, std::memory_order_relaxed);
+                mPeakBytes.store(mLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                for (auto& bucket : mHistogram) bucket.store(0, std::memory_order_relaxed);
+            }
+        private:
+            static size_t bucketOf(uint64_t bytes) noexcept {
+                return bytes == 0 ? 0 : 64 - __builtin_clzll(bytes);
+            }
+        private:
+            std::atomic<uint64_t> mAllocations{0};
+            std::atomic<uint64_t> mDeallocations{0};
+            std::atomic<uint64_t> mBytesAllocated{0};
+            std::atomic<uint64_t> mLiveBytes{0};
+            std::atomic<uint64_t> mPeakBytes{0};
+            std::atomic<uint64_t> mHistogram[65]{};
+    };
+
+    // Wraps any allocator and reports every allocation and deallocation to an allocationStats.
+    // Default-constructed instances report to allocationStats::global().
+    template<typename Alloc>
+    struct statsAllocator {
+        private:
+            using innerTraits = allocatorTraits<Alloc>;
+        public:
+            using valueType = typename innerTraits::valueType;
+            using pointer = typename innerTraits::pointer;
+            using sizeType = typename innerTraits::sizeType;
+            using propagateOnContainerCopyAssignment = typename innerTraits::propagateOnContainerCopyAssignment;
+            using propagateOnContainerMoveAssignment = typename innerTraits::propagateOnContainerMoveAssignment;
+            using propagateOnContainerSwap = typename innerTraits::propagateOnContainerSwap;
+            using isAlwaysEqual = falseType;
+            template<typename U>
+            using rebind = statsAllocator<typename innerTraits::template rebindAlloc<U>>;
+        public:
+            statsAllocator() : mStats{&allocationStats::global()} {}
+            explicit statsAllocator(allocationStats& stats, const Alloc& inner = Alloc()) : mStats{&stats}, mInner{inner} {}
+            template<typename OtherAlloc>
+            statsAllocator(const statsAllocator<OtherAlloc>& other) : mStats{&other.stats()}, mInner(other.inner()) {}
+        public:
+            friend bool operator==(const statsAllocator& lhs, const statsAllocator& rhs) {
+                return lhs.mStats == rhs.mStats && lhs.mInner == rhs.mInner;
+            }
+            friend bool operator!=(const statsAllocator& lhs, const statsAllocator& rhs) { return !(lhs == rhs); }
+        public:
+            pointer allocate(sizeType bufSize) {
+                pointer result = innerTraits::allocate(mInner, bufSize);
+                mStats->recordAllocate(sizeof(valueType) * bufSize);
+                return result;
+            }
+
+            void deallocate(pointer allocated, sizeType allocatedSize) {
+                mStats->recordDeallocate(sizeof(valueType) * allocatedSize);
+                innerTraits::deallocate(mInner, allocated, allocatedSize);
+            }
+
+            template<typename T, typename... Args>
+            void construct(T* ptr, Args&&... args) {
+                innerTraits::construct(mInner, ptr, std::forward<Args>(args)...);
+            }
+
+            template<typename T>
+            void destroy(T* ptr) {
+                innerTraits::destroy(mInner, ptr);
+            }
+
+            allocationStats& stats() const noexcept { return *mStats; }
+            const Alloc& inner() const noexcept { return mInner; }
+        private:
+            allocationStats* mStats;
+            Alloc mInner;
+    };
+}
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "utility.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace goose {
+    enum class mmapMode {
+        // The file must exist. Elements are mapped read-only; writing through them faults.
+        readOnly,
+        // Opens the file, or creates an empty one, and allows changes and appends.
+        readWrite,
+    };
+
+    namespace _implementation {
+        // Fixed 64-byte header at the start of every mmapVector file. Elements follow it, so
+        // anything aligned to at most 64 bytes is correctly aligned in the mapping.
+        struct _mmapHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t headerSize;
+            uint64_t elementSize;
+            uint64_t elementAlign;
+            uint64_t size;
+            char reserved[24];
+        };
+        static_assert(sizeof(_mmapHeader) == 64);
+
+        inline constexpr char _mmapMagic[8] = {'G', 'O', 'O', 'S', 'E', 'M', 'M', 'V'};
+        inline constexpr uint32_t _mmapVersion = 1;
+
+        [[noreturn]] inline void _throwErrno(const char* what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+    }
+
+    // Vector of trivially copyable records that lives in a file mapped with mmap. Opening is
+    // O(1) whatever the file size: nothing is read or copied up front, and pages come in on first
+    // touch. In readWrite mode the vector can grow; the file is extended with ftruncate and
+    // remapped, which invalidates pointers just as reallocation does for goose::vector. Writes
+    // reach the file when the kernel flushes them, or at once with sync().
+    template<typename T>
+    struct mmapVector {
+        static_assert(std::is_trivially_copyable_v<T>, "mmapVector stores raw bytes, so T must be trivially copyable");
+        static_assert(alignof(T) <= sizeof(_implementation::_mmapHeader), "mmapVector elements are aligned to at most 64 bytes");
+        private:
+            using header = _implementation::_mmapHeader;
+        public:
+            using valueType = T;
+            using sizeType = size_t;
+            using differenceType = std::ptrdiff_t;
+            using reference = valueType&;
+            using constReference = const valueType&;
+            using pointer = valueType*;
+            using constPointer = const valueType*;
+            using iterator = valueType*;
+            using constIterator = const valueType*;
+            using reverseIterator = goose::reverseIterator<iterator>;
+            using constReverseIterator = goose::reverseIterator<constIterator>;
+        public:
+            mmapVector() noexcept = default;
+
+            mmapVector(const char* path, mmapMode mode = mmapMode::readOnly) {
+                open(path, mode);
+            }
+
+            mmapVector(const mmapVector&) = delete;
+            mmapVector& operator=(const mmapVector&) = delete;
+
+            mmapVector(mmapVector&& other) noexcept { stealFrom(other); }
+
+            mmapVector& operator=(mmapVector&& other) noexcept {
+                if (this != &other) {
+                    close();
+                    stealFrom(other);
+                }
+                return *this;
+            }
+
+            ~mmapVector() { close(); }
+        public:
+            // Throws std::system_error when a system call fails and std::runtime_error when the
+            // file is not an mmapVector file of this element type.
+            void open(const char* path, mmapMode mode = mmapMode::readOnly) {
+                close();
+                int flags = mode == mmapMode::readOnly ? O_RDONLY : O_RDWR | O_CREAT;
+                int fd = ::open(path, flags | O_CLOEXEC, 0644);
+                if (fd < 0) _implementation::_throwErrno("mmapVector: open");
+                mFd = fd;
+                mMode = mode;
+                try {
+                    struct stat info;
+                    if (::fstat(fd, &info) != 0) _implementation::_throwErrno("mmapVector: fstat");
+                    auto fileSize = static_cast<uint64_t>(info.st_size);
+                    if (fileSize == 0 && mode == mmapMode::readWrite) {
+                        resizeFile(sizeof(header));
+                        fileSize = sizeof(header);
+                        map(fileSize);
+                        initHeader();
+                    } else {
+                        if (fileSize < sizeof(header)) throw std::runtime_error("mmapVector: file too small for a header");
+                        map(fileSize);
+                        validateHeader(fileSize);
+                    }
+                } catch (...) {
+                    release();
+                    throw;
+                }
+            }
+
+            // Unmaps and closes the file. A writable file is first trimmed to its contents; if that
+            // fails the spare capacity simply stays in the file, since the header records the size.
+            void close() noexcept {
+                if (mFd < 0) return;
+                if (mMode == mmapMode::readWrite && mCap != size()) {
+                    (void)::ftruncate(mFd, static_cast<off_t>(sizeof(header) + size() * sizeof(T)));
+                }
+                release();
+            }
+
+            bool isOpen() const noexcept { return mFd >= 0; }
+            mmapMode mode() const noexcept { return mMode; }
+
+            // Blocks until every change so far is on disk.
+            void sync() {
+                if (mMap && mMode == mmapMode::readWrite && ::msync(mMap, mMapSize, MS_SYNC) != 0) {
+                    _implementation::_throwErrno("mmapVector: msync");
+                }
+            }
+        public:
+            reference operator[](sizeType pos) noexcept { return data()[pos]; }
+            constReference operator[](sizeType pos) const noexcept { return data()[pos]; }
+            reference at(sizeType pos) noexcept { return data()[pos]; }
+            constReference at(sizeType pos) const noexcept { return data()[pos]; }
+
+            reference front() noexcept { return data()[0]; }
+            constReference front() const noexcept { return data()[0]; }
+
+            reference back() noexcept { return data()[size() - 1]; }
+            constReference back() const noexcept { return data()[size() - 1]; }
+
+            T* data() noexcept { return elements(); }
+            const T* data() const noexcept { return elements(); }
+        public:
+            iterator begin() { return data(); }
+            constIterator begin() const { return cbegin(); }
+            constIterator cbegin() const { return data(); }
+            iterator end() { return data() + size(); }
+            constIterator end() const { return cend(); }
+            constIterator cend() const { return data() + size(); }
+            reverseIterator rbegin() { return end(); }
+            reverseIterator rend() { return begin(); }
+            constReverseIterator rbegin() const { return crbegin(); }
+            constReverseIterator rend() const { return crend(); }
+            constReverseIterator crbegin() const { return cend(); }
+            constReverseIterator crend() const { return cbegin(); }
+        public:
+            sizeType size() const noexcept { return mMap ? static_cast<sizeType>(mapHeader()->size) : 0; }
+            sizeType capacity() const noexcept { return mCap; }
+            bool empty() const noexcept { return size() == 0; }
+        public:
+            // The rest of the interface needs readWrite mode.
+            void reserve(sizeType newCap) {
+                if (newCap > mCap) grow(newCap);
+            }
+
+            void clear() noexcept {
+                if (mMap) mapHeader()->size = 0;
+            }
+
+            void pushBack(const T& value) { emplaceBack(value); }
+
+            template<typename... Args>
+            reference emplaceBack(Args&&... args) {
+                sizeType count = size();
+                // Built first, so that value may refer to an element of this vector.
+                T value(std::forward<Args>(args)...);
+                if (count == mCap) grow(nextCapacity(count + 1));
+                T* slot = ::new (static_cast<void*>(data() + count)) T(value);
+                mapHeader()->size = count + 1;
+                return *slot;
+            }
+
+            void popBack() noexcept { --mapHeader()->size; }
+
+            // New elements are value-initialized.
+            void resize(sizeType count) {
+                sizeType oldSize = size();
+                if (count > mCap) grow(count);
+                for (sizeType i = oldSize; i < count; ++i) ::new (static_cast<void*>(data() + i)) T();
+                mapHeader()->size = count;
+            }
+
+            template<typename InputIt>
+            void append(InputIt first, InputIt last) {
+                for (; first != last; ++first) emplaceBack(*first);
+            }
+        private:
+            header* mapHeader() const noexcept { return static_cast<header*>(mMap); }
+
+            T* elements() const noexcept {
+                return mMap ? reinterpret_cast<T*>(static_cast<char*>(mMap) + sizeof(header)) : nullptr;
+            }
+
+            sizeType nextCapacity(sizeType required) const noexcept {
+                sizeType minimum = 4096 / sizeof(T) + 1;
+                sizeType doubled = mCap * 2;
+                sizeType result = doubled > minimum ? doubled : minimum;
+                return result > required ? result : required;
+            }
+
+            void initHeader() noexcept {
+                header* h = mapHeader();
+                std::memset(h, 0, sizeof(header));
+                std::memcpy(h->magic, _implementation::_mmapMagic, sizeof(h->magic));
+                h->version = _implementation::_mmapVersion;
+                h->headerSize = sizeof(header);
+                h->elementSize = sizeof(T);
+                h->elementAlign = alignof(T);
+                h->size = 0;
+            }
+
+            void validateHeader(uint64_t fileSize) const {
+                const header* h = mapHeader();
+                if (std::memcmp(h->magic, _implementation::_mmapMagic, sizeof(h->magic)) != 0) {
+                    throw std::runtime_error("mmapVector: not an mmapVector file");
+                }
+                if (h->version != _implementation::_mmapVersion || h->headerSize != sizeof(header)) {
+                    throw std::runtime_error("mmapVector: unsupported file version");
+                }
+                if (h->elementSize != sizeof(T) || h->elementAlign != alignof(T)) {
+                    throw std::runtime_error("mmapVector: element size or alignment does not match the file");
+                }
+                if (h->size > mCap || (fileSize - sizeof(header)) % sizeof(T) != 0) {
+                    throw std::runtime_error("mmapVector: file is truncated or corrupt");
+                }
+            }
+
+            void resizeFile(uint64_t bytes) {
+                if (::ftruncate(mFd, static_cast<off_t>(bytes)) != 0) _implementation::_throwErrno("mmapVector: ftruncate");
+            }
+
+            void map(uint64_t bytes) {
+                int prot = mMode == mmapMode::readOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+                void* address = ::mmap(nullptr, bytes, prot, MAP_SHARED, mFd, 0);
+                if (address == MAP_FAILED) _implementation::_throwErrno("mmapVector: mmap");
+                if (mMap) ::munmap(mMap, mMapSize);
+                mMap = address;
+                mMapSize = bytes;
+                mCap = static_cast<sizeType>((bytes - sizeof(header)) / sizeof(T));
+            }
+
+            // Extends the file before mapping the larger view, so a failure leaves the old mapping
+            // in place and the elements intact.
+            void grow(sizeType newCap) {
+                if (mMode != mmapMode::readWrite) throw std::logic_error("mmapVector: the file was opened read-only");
+                uint64_t bytes = sizeof(header) + static_cast<uint64_t>(newCap) * sizeof(T);
+                resizeFile(bytes);
+                map(bytes);
+            }
+
+            void release() noexcept {
+                if (mMap) ::munmap(mMap, mMapSize);
+                if (mFd >= 0) ::close(mFd);
+                mMap = nullptr;
+                mMapSize = 0;
+                mCap = 0;
+                mFd = -1;
+            }
+
+            void stealFrom(mmapVector& other) noexcept {
+                mMap = goose::exchange(other.mMap, nullptr);
+                mMapSize = goose::exchange(other.mMapSize, 0);
+                mCap = goose::exchange(other.mCap, 0);
+                mFd = goose::exchange(other.mFd, -1);
+                mMode = other.mMode;
+            }
+        private:
+            void* mMap{nullptr};
+            uint64_t mMapSize{0};
+            sizeType mCap{0};
+            int mFd{-1};
+            mmapMode mMode{mmapMode::readOnly};
+    };
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "array.hpp"
+#include "memory.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace goose {
+    // Pass as mpmcQueue's Capacity to choose the capacity at construction time instead.
+    inline constexpr size_t dynamicCapacity = 0;
+
+    namespace _implementation {
+        // Each slot's sequence number says whose turn it is: equal to a position means a producer
+        // may fill it, one past means a consumer may empty it.
+        template<typename T>
+        struct _mpmcSlot {
+            std::atomic<size_t> sequence{0};
+            alignas(T) std::byte storage[sizeof(T)];
+
+            T* ptr() noexcept { return reinterpret_cast<T*>(&storage); }
+        };
+
+        template<typename Slot, size_t Capacity, typename Alloc>
+        struct _mpmcStorage {
+            static_assert((Capacity & (Capacity - 1)) == 0, "mpmcQueue capacity must be a power of two");
+            static_assert(Capacity >= 2, "mpmcQueue needs at least two slots to tell a full slot from a free one");
+
+            Slot* slots() noexcept { return &mSlots[0]; }
+            static constexpr size_t capacity() noexcept { return Capacity; }
+
+            goose::array<Slot, Capacity> mSlots;
+        };
+
+        template<typename Slot, typename Alloc>
+        struct _mpmcStorage<Slot, dynamicCapacity, Alloc> {
+            private:
+                using slotAlloc = typename allocatorTraits<Alloc>::template rebindAlloc<Slot>;
+                using slotTraits = allocatorTraits<slotAlloc>;
+            public:
+                _mpmcStorage(size_t capacity, const Alloc& alloc) : mCapacity{roundUp(capacity)}, mAlloc(alloc) {
+                    mSlots = slotTraits::allocate(mAlloc, mCapacity);
+                    for (size_t i = 0; i < mCapacity; ++i) constructAt(mSlots + i);
+                }
+
+                _mpmcStorage(const _mpmcStorage&) = delete;
+                _mpmcStorage& operator=(const _mpmcStorage&) = delete;
+
+                ~_mpmcStorage() {
+                    for (size_t i = 0; i < mCapacity; ++i) destroyAt(mSlots + i);
+                    slotTraits::deallocate(mAlloc, mSlots, mCapacity);
+                }
+
+                Slot* slots() noexcept { return mSlots; }
+                size_t capacity() const noexcept { return mCapacity; }
+            private:
+                static size_t roundUp(size_t capacity) noexcept {
+                    size_t rounded = 2;
+                    while (rounded < capacity) rounded *= 2;
+                    return rounded;
+                }
+
+                Slot* mSlots{nullptr};
+                size_t mCapacity;
+                slotAlloc mAlloc;
+        };
+    }
+
+    // Bounded multi-producer/multi-consumer queue after Dmitry Vyukov's design: producers and
+    // consumers each claim a position with one CAS, and per-slot sequence numbers hand slots over
+    // without a lock. The try* calls never block. push() and pop() spin briefly and then sleep
+    // until the other side makes room or data. Capacity is a power of two, at least 2, fixed at
+    // compile time, or dynamicCapacity to take it from the constructor (rounded up) and allocate
+    // through Alloc.
+    template<typename T, size_t Capacity = dynamicCapacity, typename Alloc = allocator<T>>
+    struct mpmcQueue {
+        private:
+            using slot = _implementation::_mpmcSlot<T>;
+            using storage = _implementation::_mpmcStorage<slot, Capacity, Alloc>;
+        public:
+            using valueType = T;
+            using sizeType = size_t;
+        public:
+            template<size_t C = Capacity, typename = enableIfT<C != dynamicCapacity>>
+            mpmcQueue() {
+                initSequences();
+            }
+
+            template<size_t C = Capacity, typename = enableIfT<C == dynamicCapacity>>
+            explicit mpmcQueue(sizeType capacity, const Alloc& alloc = Alloc()) : mStorage(capacity, alloc) {
+                initSequences();
+            }
+
+            mpmcQueue(const mpmcQueue&) = delete;
+            mpmcQueue& operator=(const mpmcQueue&) = delete;
+
+            ~mpmcQueue() {
+                size_t end = mEnqueuePos.load(std::memory_order_relaxed);
+                for (size_t pos = mDequeuePos.load(std::memory_order_relaxed); pos != end; ++pos) {
+                    destroyAt(slotAt(pos).ptr());
+                }
+            }
+        public:
+            sizeType capacity() const noexcept { return mStorage.capacity(); }
+
+            // A snapshot only; other threads may change it at any time.
+            sizeType size() const noexcept {
+                size_t dequeued = mDequeuePos.load(std::memory_order_acquire);
+                size_t enqueued = mEnqueuePos.load(std::memory_order_acquire);
+                return enqueued > dequeued ? enqueued - dequeued : 0;
+            }
+            bool empty() const noexcept { return size() == 0; }
+        public:
+            bool tryPush(const T& value) { return tryEmplace(value); }
+            bool tryPush(T&& value) { return tryEmplace(std::move(value)); }
+
+            template<typename... Args>
+            bool tryEmplace(Args&&... args) {
+                if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+                    slot* target = claimForPush();
+                    if (!target) return false;
+                    constructAt(target->ptr(), std::forward<Args>(args)...);
+                    publishPush(target);
+                } else {
+                    // Once a slot is claimed it has to be published, so anything that can throw
+                    // happens before claiming it. Rvalue args are consumed even if the queue is full.
+                    static_assert(std::is_nothrow_move_constructible_v<T>, "mpmcQueue elements need a nothrow move constructor");
+                    T value(std::forward<Args>(args)...);
+                    slot* target = claimForPush();
+                    if (!target) return false;
+                    constructAt(target->ptr(), std::move(value));
+                    publishPush(target);
+                }
+                return true;
+            }
+
+            bool tryPop(T& out) {
+                // A claimed slot has to be released, so handing the element over must not throw.
+                static_assert(std::is_nothrow_move_assignable_v<T>, "mpmcQueue elements need a nothrow move assignment");
+                size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+                slot* source;
+                while (true) {
+                    source = &slotAt(pos);
+                    size_t sequence = source->sequence.load(std::memory_order_acquire);
+                    auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+                    if (diff == 0) {
+                        if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = mDequeuePos.load(std::memory_order_relaxed);
+                    }
+                }
+                out = std::move(*source->ptr());
+                destroyAt(source->ptr());
+                source->sequence.store(pos + capacity(), std::memory_order_release);
+                wakeOne(mProducerWaits, mNotFull);
+                return true;
+            }
+
+            void push(const T& value) {
+                waitUntil(mProducerWaits, mNotFull, [&] { return tryPush(value); });
+            }
+
+            void push(T&& value) {
+                waitUntil(mProducerWaits, mNotFull, [&] { return tryPush(std::move(value)); });
+            }
+
+            T pop() {
+                T out;
+                waitUntil(mConsumerWaits, mNotEmpty, [&] { return tryPop(out); });
+                return out;
+            }
+        private:
+            slot& slotAt(size_t pos) const noexcept {
+                return const_cast<storage&>(mStorage).slots()[pos & (capacity() - 1)];
+            }
+
+            void initSequences() noexcept {
+                for (size_t i = 0; i < capacity(); ++i) mStorage.slots()[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            // Returns the slot at the claimed position, or null when the queue is full.
+            slot* claimForPush() noexcept {
+                size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+                while (true) {
+                    slot& target = slotAt(pos);
+                    size_t sequence = target.sequence.load(std::memory_order_acquire);
+                    auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+                    if (diff == 0) {
+                        if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return &target;
+                    } else if (diff < 0) {
+                        return nullptr;
+                    } else {
+                        pos = mEnqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            // The slot's sequence still equals the position it was claimed at.
+            void publishPush(slot* target) {
+                target->sequence.store(target->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                wakeOne(mConsumerWaits, mNotEmpty);
+            }
+
+            struct waiters {
+                std::atomic<size_t> sleeping{0};
+                std::atomic<size_t> epoch{0};
+            };
+
+            // Sleepers announce themselves before their last attempt and wakers check after their
+            // publishing store; the fences on both sides make sure at least one of them notices.
+            // The epoch catches a wake that lands between a failed attempt and the wait.
+            void wakeOne(waiters& side, std::condition_variable& cv) {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (side.sleeping.load(std::memory_order_relaxed) == 0) return;
+                {
+                    std::lock_guard<std::mutex> guard(mSleepLock);
+                    side.epoch.fetch_add(1, std::memory_order_relaxed);
+                }
+                cv.notify_one();
+            }
+
+            template<typename F>
+            void waitUntil(waiters& side, std::condition_variable& cv, F attempt) {
+                for (int spin = 0; spin < 64; ++spin) {
+                    if (attempt()) return;
+                    if (spin >= 16) std::this_thread::yield();
+                }
+                side.sleeping.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                while (true) {
+                    size_t seen = side.epoch.load(std::memory_order_relaxed);
+                    if (attempt()) break;
+                    std::unique_lock<std::mutex> guard(mSleepLock);
+                    cv.wait(guard, [&] { return side.epoch.load(std::memory_order_relaxed) != seen; });
+                }
+                side.sleeping.fetch_sub(1, std::memory_order_relaxed);
+            }
+        private:
+            alignas(cacheLineSize) std::atomic<size_t> mEnqueuePos{0};
+            alignas(cacheLineSize) std::atomic<size_t> mDequeuePos{0};
+            alignas(cacheLineSize) waiters mProducerWaits;
+            waiters mConsumerWaits;
+            std::mutex mSleepLock;
+            std::condition_variable mNotFull;
+            std::condition_variable mNotEmpty;
+            storage mStorage;
+    };
+}
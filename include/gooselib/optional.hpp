@@ -2,156 +2,277 @@
 
 #include <utility>
 #include "type_traits.hpp"
+#include "memory.hpp"
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace goose {
+    // Customization point that lets optional<T> drop its flag and mark emptiness with a value T
+    // can hold but never uses. Specialize it (for example by deriving from sentinelNiche) or pass
+    // a niche as optional's second argument. An enabled niche provides:
+    //     static constexpr bool enabled = true;
+    //     static T empty();                 // the value stored while the optional is empty
+    //     static bool isEmpty(const T&);    // true only for that value
+    // Storing the empty value itself in such an optional makes it read back as empty.
     template<typename T>
-    struct optional {
+    struct optionalNiche {
+        static constexpr bool enabled = false;
+    };
+
+    template<typename T, T Sentinel>
+    struct sentinelNiche {
+        static constexpr bool enabled = true;
+        static constexpr T empty() noexcept { return Sentinel; }
+        static constexpr bool isEmpty(const T& value) noexcept { return value == Sentinel; }
+    };
+
+    template<typename T>
+    struct nullNiche {
+        static_assert(std::is_pointer_v<T>, "nullNiche is for pointer types");
+        static constexpr bool enabled = true;
+        static constexpr T empty() noexcept { return nullptr; }
+        static constexpr bool isEmpty(T value) noexcept { return value == nullptr; }
+    };
+
+    // Uses one specific quiet NaN payload, so ordinary NaNs can still be stored as values.
+    template<typename T>
+    struct nanNiche {
+        private:
+            static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "nanNiche is for float and double");
+            using bitsType = conditional<sizeof(T) == 4, uint32_t, uint64_t>;
+            static constexpr bitsType bits = sizeof(T) == 4 ? bitsType(0x7FC0600Du) : bitsType(0x7FF8600D600D600Dull);
         public:
-            optional() noexcept = default;
+            static constexpr bool enabled = true;
+            static T empty() noexcept {
+                T value;
+                std::memcpy(&value, &bits, sizeof(T));
+                return value;
+            }
+            static bool isEmpty(const T& value) noexcept { return std::memcmp(&value, &bits, sizeof(T)) == 0; }
+    };
 
-            optional(const T& val) : mHasValue{true} {
-                constructEmplace(val);
+    template<typename T, typename Niche>
+    struct optional;
+
+    namespace _implementation {
+        template<typename T>
+        struct _isOptional : falseType { };
+        template<typename T, typename Niche>
+        struct _isOptional<optional<T, Niche>> : trueType { };
+
+        // Payload plus the representation of emptiness: a flag after the buffer, or the niche value.
+        template<typename T, typename Niche, bool = Niche::enabled>
+        struct _optionalStorage {
+            alignas(T) std::byte mBuffer[sizeof(T)]{};
+            bool mHasValue{false};
+
+            bool hasValue() const noexcept { return mHasValue; }
+            T* ptr() noexcept { return reinterpret_cast<T*>(&mBuffer); }
+            const T* ptr() const noexcept { return reinterpret_cast<const T*>(&mBuffer); }
+
+            // Expects the optional to be empty.
+            template<typename... Args>
+            void constructEmplace(Args&&... args) {
+                constructAt(ptr(), std::forward<Args>(args)...);
+                mHasValue = true;
             }
 
-            optional(T&& val) : mHasValue{true} { 
-                constructEmplace(std::move(val));
+            void clear() noexcept {
+                if (mHasValue) {
+                    destroyAt(ptr());
+                    mHasValue = false;
+                }
             }
 
-            template<typename U>
-            optional(const U& val) : mHasValue{true} {
-                constructEmplace(val);
+            void destroyStorage() noexcept { clear(); }
+        };
+
+        template<typename T, typename Niche>
+        struct _optionalStorage<T, Niche, true> {
+            alignas(T) std::byte mBuffer[sizeof(T)];
+
+            _optionalStorage() noexcept(noexcept(Niche::empty())) { constructAt(ptr(), Niche::empty()); }
+
+            bool hasValue() const noexcept { return !Niche::isEmpty(*ptr()); }
+            T* ptr() noexcept { return reinterpret_cast<T*>(&mBuffer); }
+            const T* ptr() const noexcept { return reinterpret_cast<const T*>(&mBuffer); }
+
+            template<typename... Args>
+            void constructEmplace(Args&&... args) {
+                destroyAt(ptr());
+                try {
+                    constructAt(ptr(), std::forward<Args>(args)...);
+                } catch (...) {
+                    constructAt(ptr(), Niche::empty());
+                    throw;
+                }
             }
 
-            optional(const optional& other) {
-                if (other) {
-                    constructEmplace(*other);
-                    mHasValue = true;
-                } 
+            void clear() noexcept {
+                if (hasValue()) {
+                    destroyAt(ptr());
+                    constructAt(ptr(), Niche::empty());
+                }
             }
 
-            optional(optional&& other) {
-                if (other) {
-                    constructEmplace(std::move(*other));
-                    mHasValue = true;
-                } 
-            }               
+            void destroyStorage() noexcept { destroyAt(ptr()); }
+        };
 
-            template<typename U>
-            optional(const optional<U>& other) {
-                if (other) {
-                    constructEmplace(*other);
-                    mHasValue = true;
-                } 
-            }
+        // Trivially copyable payloads get defaulted, and therefore trivial, copy/move/destructor.
+        template<typename T, typename Niche,
+                 bool = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>>
+        struct _optionalBase : _optionalStorage<T, Niche> { };
 
-            template<typename U>
-            optional(optional<U>&& other) {
-                if (other) {
-                    constructEmplace(std::move(*other));
-                    mHasValue = true;
-                } 
+        template<typename T, typename Niche>
+        struct _optionalBase<T, Niche, false> : _optionalStorage<T, Niche> {
+            _optionalBase() = default;
+
+            _optionalBase(const _optionalBase& other) {
+                if (other.hasValue()) this->constructEmplace(*other.ptr());
             }
 
-            template<typename... Args>
-            optional(std::in_place_t, Args&&... args) : mHasValue{true} {
-               constructEmplace(std::forward<Args>(args)...);
+            _optionalBase(_optionalBase&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+                if (other.hasValue()) this->constructEmplace(std::move(*other.ptr()));
             }
 
-            optional& operator=(const optional& other) {
+            _optionalBase& operator=(const _optionalBase& other) {
                 if (this == &other) return *this;
-                if (other) {
-                    if (*this) {
-                        **this = *other;
+                if (other.hasValue()) {
+                    if (this->hasValue()) {
+                        *this->ptr() = *other.ptr();
                     } else {
-                        constructEmplace(*other);
+                        this->constructEmplace(*other.ptr());
                     }
-                    mHasValue = true;
                 } else {
-                    clear();
+                    this->clear();
                 }
                 return *this;
             }
 
-            optional& operator=(optional&& other) {
+            _optionalBase& operator=(_optionalBase&& other) noexcept(std::is_nothrow_move_constructible_v<T>
+                                                                     && std::is_nothrow_move_assignable_v<T>) {
                 if (this == &other) return *this;
-                if (other) {
-                    if (*this) {
-                        **this = std::move(*other);
+                if (other.hasValue()) {
+                    if (this->hasValue()) {
+                        *this->ptr() = std::move(*other.ptr());
                     } else {
-                        constructEmplace(std::move(*other));
+                        this->constructEmplace(std::move(*other.ptr()));
                     }
-                    mHasValue = true;
                 } else {
-                    clear();
+                    this->clear();
                 }
                 return *this;
-            }    
-            
-            template<typename U>
-            optional& operator=(const optional<U>& other) {
-                if (this == &other) return *this;
+            }
+
+            ~_optionalBase() {
+                this->destroyStorage();
+            }
+        };
+    }
+
+    template<typename T, typename Niche = optionalNiche<T>>
+    struct optional : private _implementation::_optionalBase<T, Niche> {
+        private:
+            using base = _implementation::_optionalBase<T, Niche>;
+        public:
+            optional() noexcept = default;
+
+            optional(const T& val) {
+                this->constructEmplace(val);
+            }
+
+            optional(T&& val) {
+                this->constructEmplace(std::move(val));
+            }
+
+            template<typename U, typename = enableIfT<!_implementation::_isOptional<U>::value && !std::is_same_v<U, T>>>
+            optional(const U& val) {
+                this->constructEmplace(val);
+            }
+
+            optional(const optional& other) = default;
+            optional(optional&& other) = default;
+
+            template<typename U, typename N>
+            optional(const optional<U, N>& other) {
+                if (other) this->constructEmplace(*other);
+            }
+
+            template<typename U, typename N>
+            optional(optional<U, N>&& other) {
+                if (other) this->constructEmplace(std::move(*other));
+            }
+
+            template<typename... Args>
+            optional(std::in_place_t, Args&&... args) {
+               this->constructEmplace(std::forward<Args>(args)...);
+            }
+
+            optional& operator=(const optional& other) = default;
+            optional& operator=(optional&& other) = default;
+
+            template<typename U, typename N>
+            optional& operator=(const optional<U, N>& other) {
                 if (other) {
                     if (*this) {
                         **this = *other;
                     } else {
-                        constructEmplace(*other);
+                        this->constructEmplace(*other);
                     }
-                    mHasValue = true;
                 } else {
                     clear();
                 }
                 return *this;
             }
 
-            template<typename U>
-            optional& operator=(optional<U>&& other) {
-                if (this == &other) return *this;
+            template<typename U, typename N>
+            optional& operator=(optional<U, N>&& other) {
                 if (other) {
                     if (*this) {
                         **this = std::move(*other);
                     } else {
-                        constructEmplace(std::move(*other));
+                        this->constructEmplace(std::move(*other));
                     }
-                    mHasValue = true;
                 } else {
                     clear();
                 }
                 return *this;
             }
 
-            ~optional() {
-                clear();
-            }
+            ~optional() = default;
 
         public:
             [[nodiscard]] T& operator*() { return value(); }
             [[nodiscard]] const T& operator*() const { return value(); }
-            [[nodiscard]] T& value() { return *reinterpret_cast<T*>(&mBuffer); }
-            [[nodiscard]] const T& value() const { return *reinterpret_cast<const T*>(&mBuffer); }
+            T* operator->() { return this->ptr(); }
+            const T* operator->() const { return this->ptr(); }
+            [[nodiscard]] T& value() { return *this->ptr(); }
+            [[nodiscard]] const T& value() const { return *this->ptr(); }
+
+            template<typename U>
+            T valueOr(U&& fallback) const {
+                return hasValue() ? value() : static_cast<T>(std::forward<U>(fallback));
+            }
 
             bool hasValue() const {
-                return mHasValue;
+                return base::hasValue();
             }
 
             operator bool() const {
                 return hasValue();
             }
 
-            void clear() {
-                if (mHasValue) {
-                    this->value().~T();
-                    mHasValue = false;
-                }
+            template<typename... Args>
+            T& emplace(Args&&... args) {
+                clear();
+                this->constructEmplace(std::forward<Args>(args)...);
+                return value();
             }
 
-        private:
-            template<typename... Args>
-            void constructEmplace(Args&& ... args) {
-                construct_at(mBuffer);
+            void clear() {
+                base::clear();
             }
-        private:
-            alignas(T) std::byte mBuffer[sizeof(T)]{};
-            bool mHasValue{false};
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,431 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace goose {
+    // Lazy views over goose::Range. Each view stores the view below it by value and produces
+    // elements on the fly as it is iterated, so a chain such as
+    //     values | views::filter(isValid) | views::transform(parse) | views::take(100)
+    // walks the source once and allocates nothing. Functions are called through const references
+    // and must outlive nothing but the view itself; iterators must not outlive their view.
+    struct viewBase { };
+
+    template<typename T>
+    struct isView : std::is_base_of<viewBase, T> { };
+    template<typename Begin, typename End>
+    struct isView<Range<Begin, End>> : trueType { };
+
+    template<typename T>
+    inline constexpr bool isViewV = isView<removeCV<removeReference<T>>>::value;
+
+    namespace _implementation {
+        template<typename V>
+        using _viewIterator = decltype(goose::declval<const V&>().begin());
+
+        template<typename It>
+        using _iterReference = decltype(*goose::declval<const It&>());
+
+        // Moves it forward by up to count steps without passing last.
+        template<typename It>
+        It _advanceBounded(It it, size_t count, const It& last) {
+            using category = typename iteratorTraits<It>::iteratorCategory;
+            if constexpr (std::is_base_of_v<randomAccessIteratorTag, category>) {
+                auto left = static_cast<size_t>(last - it);
+                return it + static_cast<std::ptrdiff_t>(count < left ? count : left);
+            } else {
+                for (; count && it != last; --count) ++it;
+                return it;
+            }
+        }
+
+        // Comparison and postfix increment shared by every view iterator; Derived supplies
+        // operator++ and an equals(other) member.
+        template<typename Derived>
+        struct _viewIteratorBase {
+            Derived operator++(int) {
+                Derived tmp = static_cast<const Derived&>(*this);
+                ++static_cast<Derived&>(*this);
+                return tmp;
+            }
+            friend bool operator==(const Derived& lhs, const Derived& rhs) { return lhs.equals(rhs); }
+            friend bool operator!=(const Derived& lhs, const Derived& rhs) { return !lhs.equals(rhs); }
+        };
+    }
+
+    namespace views {
+        // Wraps a container in a Range over its iterators; views pass through unchanged. The
+        // container is referenced, not copied, so it has to be an lvalue.
+        template<typename R>
+        auto all(R&& range) {
+            if constexpr (isViewV<R>) {
+                return removeCV<removeReference<R>>(std::forward<R>(range));
+            } else {
+                static_assert(std::is_lvalue_reference_v<R>, "views reference their source; pipe a named container, not a temporary");
+                return Range(range.begin(), range.end());
+            }
+        }
+    }
+
+    namespace _implementation {
+        // Result of views::filter(pred) and friends; piping a range into it applies the view.
+        template<typename F>
+        struct _rangeAdaptor {
+            F fn;
+
+            template<typename R>
+            friend auto operator|(R&& range, const _rangeAdaptor& adaptor) {
+                return adaptor.fn(views::all(std::forward<R>(range)));
+            }
+        };
+
+        template<typename F>
+        _rangeAdaptor<F> _makeAdaptor(F fn) { return {std::move(fn)}; }
+    }
+
+    template<typename V, typename Pred>
+    struct filterView : viewBase {
+        private:
+            using base = _implementation::_viewIterator<V>;
+        public:
+            struct iterator : _implementation::_viewIteratorBase<iterator> {
+                public:
+                    using reference = _implementation::_iterReference<base>;
+                    using valueType = removeCV<removeReference<reference>>;
+                    using differenceType = std::ptrdiff_t;
+                    using pointer = void;
+                    using iteratorCategory = forwardIteratorTag;
+                public:
+                    iterator() = default;
+                    iterator(base cur, base last, const Pred* pred) : mCur{cur}, mLast{last}, mPred{pred} { skip(); }
+
+                    reference operator*() const { return *mCur; }
+                    iterator& operator++() {
+                        ++mCur;
+                        skip();
+                        return *this;
+                    }
+                    using _implementation::_viewIteratorBase<iterator>::operator++;
+                    bool equals(const iterator& other) const { return mCur == other.mCur; }
+                private:
+                    void skip() {
+                        while (mCur != mLast && !(*mPred)(*mCur)) ++mCur;
+                    }
+
+                    base mCur{};
+                    base mLast{};
+                    const Pred* mPred{nullptr};
+            };
+        public:
+            filterView(V view, Pred pred) : mView{std::move(view)}, mPred{std::move(pred)} {}
+
+            iterator begin() const { return {mView.begin(), mView.end(), &mPred}; }
+            iterator end() const { return {mView.end(), mView.end(), &mPred}; }
+        private:
+            V mView;
+            Pred mPred;
+    };
+
+    template<typename V, typename F>
+    struct transformView : viewBase {
+        private:
+            using base = _implementation::_viewIterator<V>;
+        public:
+            struct iterator : _implementation::_viewIteratorBase<iterator> {
+                public:
+                    using reference = decltype(goose::declval<const F&>()(goose::declval<_implementation::_iterReference<base>>()));
+                    using valueType = removeCV<removeReference<reference>>;
+                    using differenceType = std::ptrdiff_t;
+                    using pointer = void;
+                    using iteratorCategory = forwardIteratorTag;
+                public:
+                    iterator() = default;
+                    iterator(base cur, const F* fn) : mCur{cur}, mFn{fn} {}
+
+                    reference operator*() const { return (*mFn)(*mCur); }
+                    iterator& operator++() {
+                        ++mCur;
+                        return *this;
+                    }
+                    using _implementation::_viewIteratorBase<iterator>::operator++;
+                    bool equals(const iterator& other) const { return mCur == other.mCur; }
+                private:
+                    base mCur{};
+                    const F* mFn{nullptr};
+            };
+        public:
+            transformView(V view, F fn) : mView{std::move(view)}, mFn{std::move(fn)} {}
+
+            iterator begin() const { return {mView.begin(), &mFn}; }
+            iterator end() const { return {mView.end(), &mFn}; }
+        private:
+            V mView;
+            F mFn;
+    };
+
+    template<typename V>
+    struct takeView : viewBase {
+        private:
+            using base = _implementation::_viewIterator<V>;
+        public:
+            struct iterator : _implementation::_viewIteratorBase<iterator> {
+                public:
+                    using reference = _implementation::_iterReference<base>;
+                    using valueType = removeCV<removeReference<reference>>;
+                    using differenceType = std::ptrdiff_t;
+                    using pointer = void;
+                    using iteratorCategory = forwardIteratorTag;
+                public:
+                    iterator() = default;
+                    iterator(base cur, size_t remaining) : mCur{cur}, mRemaining{remaining} {}
+
+                    reference operator*() const { return *mCur; }
+                    iterator& operator++() {
+                        ++mCur;
+                        --mRemaining;
+                        return *this;
+                    }
+                    using _implementation::_viewIteratorBase<iterator>::operator++;
+                    // The end iterator has nothing remaining and sits at the end of the source, so
+                    // iteration stops at whichever of the two comes first.
+                    bool equals(const iterator& other) const { return mRemaining == other.mRemaining || mCur == other.mCur; }
+                private:
+                    base mCur{};
+                    size_t mRemaining{0};
+            };
+        public:
+            takeView(V view, size_t count) : mView{std::move(view)}, mCount{count} {}
+
+            iterator begin() const { return {mView.begin(), mCount}; }
+            iterator end() const { return {mView.end(), 0}; }
+        private:
+            V mView;
+            size_t mCount;
+    };
+
+    // Skips the first count elements when iteration starts, not when the view is built.
+    template<typename V>
+    struct dropView : viewBase {
+        public:
+            using iterator = _implementation::_viewIterator<V>;
+        public:
+            dropView(V view, size_t count) : mView{std::move(view)}, mCount{count} {}
+
+            iterator begin() const { return _implementation::_advanceBounded(mView.begin(), mCount, mView.end()); }
+            iterator end() const { return mView.end(); }
+        private:
+            V mView;
+            size_t mCount;
+    };
+
+    // Yields std::pair<size_t, reference>, which works with structured bindings.
+    template<typename V>
+    struct enumerateView : viewBase {
+        private:
+            using base = _implementation::_viewIterator<V>;
+        public:
+            struct iterator : _implementation::_viewIteratorBase<iterator> {
+                public:
+                    using reference = std::pair<size_t, _implementation::_iterReference<base>>;
+                    using valueType = reference;
+                    using differenceType = std::ptrdiff_t;
+                    using pointer = void;
+                    using iteratorCategory = forwardIteratorTag;
+                public:
+                    iterator() = default;
+                    iterator(base cur, size_t index) : mCur{cur}, mIndex{index} {}
+
+                    reference operator*() const { return reference(mIndex, *mCur); }
+                    iterator& operator++() {
+                        ++mCur;
+                        ++mIndex;
+                        return *this;
+                    }
+                    using _implementation::_viewIteratorBase<iterator>::operator++;
+                    bool equals(const iterator& other) const { return mCur == other.mCur; }
+                private:
+                    base mCur{};
+                    size_t mIndex{0};
+            };
+        public:
+            explicit enumerateView(V view) : mView{std::move(view)} {}
+
+            iterator begin() const { return {mView.begin(), 0}; }
+            iterator end() const { return {mView.end(), 0}; }
+        private:
+            V mView;
+    };
+
+    // Walks several views in lockstep, yielding a tuple of their references, and stops at the
+    // end of the shortest one.
+    template<typename... Vs>
+    struct zipView : viewBase {
+        public:
+            struct iterator : _implementation::_viewIteratorBase<iterator> {
+                public:
+                    using reference = std::tuple<_implementation::_iterReference<_implementation::_viewIterator<Vs>>...>;
+                    using valueType = reference;
+                    using differenceType = std::ptrdiff_t;
+                    using pointer = void;
+                    using iteratorCategory = forwardIteratorTag;
+                public:
+                    iterator() = default;
+                    explicit iterator(std::tuple<_implementation::_viewIterator<Vs>...> cur) : mCur{std::move(cur)} {}
+
+                    reference operator*() const {
+                        return std::apply([](const auto&... its) { return reference(*its...); }, mCur);
+                    }
+                    iterator& operator++() {
+                        std::apply([](auto&... its) { (++its, ...); }, mCur);
+                        return *this;
+                    }
+                    using _implementation::_viewIteratorBase<iterator>::operator++;
+                    bool equals(const iterator& other) const { return anyEqual(other, std::index_sequence_for<Vs...>{}); }
+                private:
+                    template<size_t... Is>
+                    bool anyEqual(const iterator& other, std::index_sequence<Is...>) const {
+                        return ((std::get<Is>(mCur) == std::get<Is>(other.mCur)) || ...);
+                    }
+
+                    std::tuple<_implementation::_viewIterator<Vs>...> mCur{};
+            };
+        public:
+            explicit zipView(Vs... views) : mViews{std::move(views)...} {}
+
+            iterator begin() const {
+                return iterator(std::apply([](const auto&... views) { return std::make_tuple(views.begin()...); }, mViews));
+            }
+            iterator end() const {
+                return iterator(std::apply([](const auto&... views) { return std::make_tuple(views.end()...); }, mViews));
+            }
+        private:
+            std::tuple<Vs...> mViews;
+    };
+
+    // Yields consecutive Ranges of size elements; the last one may be shorter.
+    template<typename V>
+    struct chunkView : viewBase {
+        private:
+            using base = _implementation::_viewIterator<V>;
+        public:
+            struct iterator : _implementation::_viewIteratorBase<iterator> {
+                public:
+                    using reference = Range<base, base>;
+                    using valueType = reference;
+                    using differenceType = std::ptrdiff_t;
+                    using pointer = void;
+                    using iteratorCategory = forwardIteratorTag;
+                public:
+                    iterator() = default;
+                    iterator(base cur, base last, size_t size)
+                        : mCur{cur}, mNext{_implementation::_advanceBounded(cur, size, last)}, mLast{last}, mSize{size} {}
+
+                    reference operator*() const { return reference(mCur, mNext); }
+                    iterator& operator++() {
+                        mCur = mNext;
+                        mNext = _implementation::_advanceBounded(mCur, mSize, mLast);
+                        return *this;
+                    }
+                    using _implementation::_viewIteratorBase<iterator>::operator++;
+                    bool equals(const iterator& other) const { return mCur == other.mCur; }
+                private:
+                    base mCur{};
+                    base mNext{};
+                    base mLast{};
+                    size_t mSize{0};
+            };
+        public:
+            chunkView(V view, size_t size) : mView{std::move(view)}, mSize{size ? size : 1} {}
+
+            iterator begin() const { return {mView.begin(), mView.end(), mSize}; }
+            iterator end() const { return {mView.end(), mView.end(), mSize}; }
+        private:
+            V mView;
+            size_t mSize;
+    };
+
+    // Yields every step-th element, starting with the first.
+    template<typename V>
+    struct strideView : viewBase {
+        private:
+            using base = _implementation::_viewIterator<V>;
+        public:
+            struct iterator : _implementation::_viewIteratorBase<iterator> {
+                public:
+                    using reference = _implementation::_iterReference<base>;
+                    using valueType = removeCV<removeReference<reference>>;
+                    using differenceType = std::ptrdiff_t;
+                    using pointer = void;
+                    using iteratorCategory = forwardIteratorTag;
+                public:
+                    iterator() = default;
+                    iterator(base cur, base last, size_t step) : mCur{cur}, mLast{last}, mStep{step} {}
+
+                    reference operator*() const { return *mCur; }
+                    iterator& operator++() {
+                        mCur = _implementation::_advanceBounded(mCur, mStep, mLast);
+                        return *this;
+                    }
+                    using _implementation::_viewIteratorBase<iterator>::operator++;
+                    bool equals(const iterator& other) const { return mCur == other.mCur; }
+                private:
+                    base mCur{};
+                    base mLast{};
+                    size_t mStep{1};
+            };
+        public:
+            strideView(V view, size_t step) : mView{std::move(view)}, mStep{step ? step : 1} {}
+
+            iterator begin() const { return {mView.begin(), mView.end(), mStep}; }
+            iterator end() const { return {mView.end(), mView.end(), mStep}; }
+        private:
+            V mView;
+            size_t mStep;
+    };
+
+    namespace views {
+        template<typename Pred>
+        auto filter(Pred pred) {
+            return _implementation::_makeAdaptor([pred = std::move(pred)](auto view) {
+                return filterView<decltype(view), Pred>(std::move(view), pred);
+            });
+        }
+
+        template<typename F>
+        auto transform(F fn) {
+            return _implementation::_makeAdaptor([fn = std::move(fn)](auto view) {
+                return transformView<decltype(view), F>(std::move(view), fn);
+            });
+        }
+
+        inline auto take(size_t count) {
+            return _implementation::_makeAdaptor([count](auto view) { return takeView<decltype(view)>(std::move(view), count); });
+        }
+
+        inline auto drop(size_t count) {
+            return _implementation::_makeAdaptor([count](auto view) { return dropView<decltype(view)>(std::move(view), count); });
+        }
+
+        inline auto enumerate() {
+            return _implementation::_makeAdaptor([](auto view) { return enumerateView<decltype(view)>(std::move(view)); });
+        }
+
+        inline auto chunk(size_t size) {
+            return _implementation::_makeAdaptor([size](auto view) { return chunkView<decltype(view)>(std::move(view), size); });
+        }
+
+        inline auto stride(size_t step) {
+            return _implementation::_makeAdaptor([step](auto view) { return strideView<decltype(view)>(std::move(view), step); });
+        }
+
+        template<typename... Rs>
+        auto zip(Rs&&... ranges) {
+            return zipView<decltype(views::all(std::forward<Rs>(ranges)))...>(views::all(std::forward<Rs>(ranges))...);
+        }
+    }
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+#include "memory.hpp"
+#include "iterator.hpp"
+#include "utility.hpp"
+#include <initializer_list>
+#include <algorithm>
+#include <type_traits>
+
+namespace goose {
+    // Vector that keeps up to N elements in an inline buffer and only goes to the allocator
+    // once it grows past that. Iterators, sizes and mutation mirror goose::vector.
+    template<typename T, size_t N, typename Alloc = allocator<T>>
+    struct smallVector {
+        private:
+            using myAllocTraits = allocatorTraits<Alloc>;
+            static constexpr size_t growthFactor = 2;
+            static_assert(N > 0, "smallVector needs room for at least one inline element");
+        public:
+            using valueType = T;
+            using allocatorType = Alloc;
+            using sizeType = size_t;
+            using differenceType = std::ptrdiff_t;
+            using reference = valueType&;
+            using constReference = const valueType&;
+            using pointer = typename myAllocTraits::pointer;
+            using constPointer = typename myAllocTraits::constPointer;
+            using iterator = valueType*;
+            using constIterator = const valueType*;
+            using reverseIterator = goose::reverseIterator<iterator>;
+            using constReverseIterator = goose::reverseIterator<constIterator>;
+
+            static constexpr sizeType inlineCapacity = N;
+        public:
+            smallVector() noexcept(std::is_nothrow_default_constructible_v<Alloc>) = default;
+            smallVector(const Alloc& alloc) : mAlloc{alloc} {}
+
+            smallVector(sizeType count, const T& value, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
+                reserve(count);
+                for (; mSize < count; ++mSize) myAllocTraits::construct(mAlloc, mElems + mSize, value);
+            }
+
+            smallVector(sizeType count, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
+                reserve(count);
+                for (; mSize < count; ++mSize) myAllocTraits::construct(mAlloc, mElems + mSize);
+            }
+
+            template<typename InputIt, typename = enableIfT<!std::is_integral_v<InputIt>>>
+            smallVector(InputIt first, InputIt last, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
+                reserve(last - first);
+                for (; first != last; ++first, ++mSize) myAllocTraits::construct(mAlloc, mElems + mSize, *first);
+            }
+
+            smallVector(std::initializer_list<T> list, const Alloc& alloc = Alloc()) : smallVector(list.begin(), list.end(), alloc) {}
+
+            smallVector(const smallVector& other) : smallVector(other.begin(), other.end(), other.mAlloc) {}
+
+            smallVector(smallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : mAlloc{std::move(other.mAlloc)} {
+                takeFrom(other);
+            }
+
+            ~smallVector() {
+                clear();
+                releaseHeap();
+            }
+
+            smallVector& operator=(const smallVector& other) {
+                if (this == &other) return *this;
+                if constexpr (myAllocTraits::propagateOnContainerCopyAssignment::value) {
+                    if (mAlloc != other.mAlloc) {
+                        clear();
+                        releaseHeap();
+                    }
+                    mAlloc = other.mAlloc;
+                }
+                assign(other.begin(), other.end());
+                return *this;
+            }
+
+            // Inline elements are always moved one by one, so T's move constructor is part of the
+            // noexcept condition even when the allocator lets the heap buffer be stolen.
+            smallVector& operator=(smallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>
+                                                                 && (myAllocTraits::propagateOnContainerMoveAssignment::value
+                                                                     || myAllocTraits::isAlwaysEqual::value)) {
+                if (this == &other) return *this;
+                clear();
+                if constexpr (myAllocTraits::propagateOnContainerMoveAssignment::value) {
+                    releaseHeap();
+                    mAlloc = std::move(other.mAlloc);
+                    takeFrom(other);
+                } else if constexpr (myAllocTraits::isAlwaysEqual::value) {
+                    releaseHeap();
+                    takeFrom(other);
+                } else {
+                    if (mAlloc == other.mAlloc) {
+                        releaseHeap();
+                        takeFrom(other);
+                    } else {
+                        // Memory from other's allocator cannot be handed to ours, so fall back to moving each element.
+                        reserve(other.mSize);
+                        for (; mSize < other.mSize; ++mSize) {
+                            myAllocTraits::construct(mAlloc, mElems + mSize, std::move(other.mElems[mSize]));
+                        }
+                        other.clear();
+                    }
+                }
+                return *this;
+            }
+
+            smallVector& operator=(std::initializer_list<T> list) {
+                assign(list.begin(), list.end());
+                return *this;
+            }
+
+        public:
+            reference operator[](sizeType pos) noexcept { return mElems[pos]; }
+            constReference operator[](sizeType pos) const noexcept { return mElems[pos]; }
+            reference at(sizeType pos) noexcept { return mElems[pos]; }
+            constReference at(sizeType pos) const noexcept { return mElems[pos]; }
+
+            reference front() noexcept { return mElems[0]; }
+            constReference front() const noexcept { return mElems[0]; }
+
+            reference back() noexcept { return mElems[mSize - 1]; }
+            constReference back() const noexcept { return mElems[mSize - 1]; }
+
+            T* data() noexcept { return mElems; }
+            const T* data() const noexcept { return mElems; }
+        public:
+            iterator begin() { return mElems; }
+            constIterator begin() const { return cbegin(); }
+            constIterator cbegin() const { return mElems; }
+            iterator end() { return mElems + mSize; }
+            constIterator end() const { return cend(); }
+            constIterator cend() const { return mElems + mSize; }
+            reverseIterator rbegin() { return end(); }
+            reverseIterator rend() { return begin(); }
+            constReverseIterator rbegin() const { return crbegin(); }
+            constReverseIterator rend() const { return crend(); }
+            constReverseIterator crbegin() const { return cend(); }
+            constReverseIterator crend() const { return cbegin(); }
+        public:
+            sizeType size() const { return mSize; }
+            sizeType capacity() const { return mCap; }
+            bool empty() const { return mSize == 0; }
+            bool isInline() const { return mElems == inlineBuffer(); }
+        public:
+            void reserve(sizeType newCap) {
+                if (newCap > mCap) reallocate(newCap);
+            }
+
+            // Moves back into the inline buffer when the elements fit, otherwise trims the heap buffer.
+            void shrinkToFit() {
+                if (isInline() || mSize == mCap) return;
+                reallocate(mSize);
+            }
+
+            void clear() noexcept {
+                destroyRange(mElems, mElems + mSize);
+                mSize = 0;
+            }
+
+            template<typename InputIt, typename = enableIfT<!std::is_integral_v<InputIt>>>
+            void assign(InputIt first, InputIt last) {
+                clear();
+                reserve(last - first);
+                for (; first != last; ++first, ++mSize) myAllocTraits::construct(mAlloc, mElems + mSize, *first);
+            }
+
+            void pushBack(const T& value) { emplaceBack(value); }
+            void pushBack(T&& value) { emplaceBack(std::move(value)); }
+
+            template<typename... Args>
+            reference emplaceBack(Args&&... args) {
+                if (mSize == mCap) {
+                    // Build the new element first: args may refer into the buffer being replaced.
+                    sizeType newCap = mCap * growthFactor;
+                    T* newElems = myAllocTraits::allocate(mAlloc, newCap);
+                    try {
+                        myAllocTraits::construct(mAlloc, newElems + mSize, std::forward<Args>(args)...);
+                    } catch (...) {
+                        myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                        throw;
+                    }
+                    try {
+                        relocate(mElems, mElems + mSize, newElems);
+                    } catch (...) {
+                        myAllocTraits::destroy(mAlloc, newElems + mSize);
+                        myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                        throw;
+                    }
+                    replaceStorage(newElems, newCap);
+                } else {
+                    myAllocTraits::construct(mAlloc, mElems + mSize, std::forward<Args>(args)...);
+                }
+                ++mSize;
+                return back();
+            }
+
+            void popBack() {
+                --mSize;
+                myAllocTraits::destroy(mAlloc, mElems + mSize);
+            }
+
+            void resize(sizeType count) {
+                if (count < mSize) {
+                    destroyRange(mElems + count, mElems + mSize);
+                    mSize = count;
+                    return;
+                }
+                if (count > mCap) reallocate(nextCapacity(count));
+                sizeType index = mSize;
+                try {
+                    for (; index < count; ++index) myAllocTraits::construct(mAlloc, mElems + index);
+                } catch (...) {
+                    destroyRange(mElems + mSize, mElems + index);
+                    throw;
+                }
+                mSize = count;
+            }
+
+            void resize(sizeType count, const T& value) {
+                if (count <= mSize) {
+                    resize(count);
+                    return;
+                }
+                T copy(value);
+                if (count > mCap) reallocate(nextCapacity(count));
+                sizeType index = mSize;
+                try {
+                    for (; index < count; ++index) myAllocTraits::construct(mAlloc, mElems + index, copy);
+                } catch (...) {
+                    destroyRange(mElems + mSize, mElems + index);
+                    throw;
+                }
+                mSize = count;
+            }
+
+            template<typename... Args>
+            iterator emplace(constIterator pos, Args&&... args) {
+                sizeType index = pos - cbegin();
+                emplaceBack(std::forward<Args>(args)...);
+                std::rotate(mElems + index, mElems + mSize - 1, mElems + mSize);
+                return begin() + index;
+            }
+
+            iterator insert(constIterator pos, const T& value) { return emplace(pos, value); }
+            iterator insert(constIterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+            iterator insert(constIterator pos, sizeType count, const T& value) {
+                sizeType index = pos - cbegin();
+                sizeType oldSize = mSize;
+                resize(mSize + count, value);
+                std::rotate(mElems + index, mElems + oldSize, mElems + mSize);
+                return begin() + index;
+            }
+
+            template<typename InputIt, typename = enableIfT<!std::is_integral_v<InputIt>>>
+            iterator insert(constIterator pos, InputIt first, InputIt last) {
+                sizeType index = pos - cbegin();
+                sizeType oldSize = mSize;
+                sizeType required = mSize + (last - first);
+                if (required > mCap) reallocate(nextCapacity(required));
+                try {
+                    for (; first != last; ++first, ++mSize) myAllocTraits::construct(mAlloc, mElems + mSize, *first);
+                } catch (...) {
+                    destroyRange(mElems + oldSize, mElems + mSize);
+                    mSize = oldSize;
+                    throw;
+                }
+                std::rotate(mElems + index, mElems + oldSize, mElems + mSize);
+                return begin() + index;
+            }
+
+            iterator insert(constIterator pos, std::initializer_list<T> list) {
+                return insert(pos, list.begin(), list.end());
+            }
+
+            iterator erase(constIterator pos) {
+                return erase(pos, pos + 1);
+            }
+
+            iterator erase(constIterator first, constIterator last) {
+                iterator dst = begin() + (first - cbegin());
+                if (first == last) return dst;
+                iterator out = std::move(begin() + (last - cbegin()), end(), dst);
+                destroyRange(out, end());
+                mSize = out - begin();
+                return dst;
+            }
+
+            // When both sides are on the heap the buffers trade places, so unless the allocator
+            // propagates on swap the two allocators must compare equal, as for vector::swap.
+            void swap(smallVector& other) {
+                if (!isInline() && !other.isInline()) {
+                    goose::swap(mElems, other.mElems);
+                    goose::swap(mSize, other.mSize);
+                    goose::swap(mCap, other.mCap);
+                    if constexpr (myAllocTraits::propagateOnContainerSwap::value) {
+                        goose::swap(mAlloc, other.mAlloc);
+                    }
+                    return;
+                }
+                smallVector tmp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(tmp);
+            }
+
+            allocatorType getAllocator() const noexcept { return mAlloc; }
+        private:
+            static constexpr bool moveRelocates = std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+
+            sizeType nextCapacity(sizeType required) const {
+                sizeType grown = mCap * growthFactor;
+                return grown < required ? required : grown;
+            }
+
+            T* inlineBuffer() noexcept { return reinterpret_cast<T*>(mInline); }
+            const T* inlineBuffer() const noexcept { return reinterpret_cast<const T*>(mInline); }
+
+            void destroyRange(T* first, T* last) noexcept {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (; first != last; ++first) myAllocTraits::destroy(mAlloc, first);
+                }
+            }
+
+            void relocate(T* first, T* last, T* dst) {
+                T* out = dst;
+                try {
+                    for (; first != last; ++first, ++out) {
+                        if constexpr (moveRelocates) {
+                            myAllocTraits::construct(mAlloc, out, std::move(*first));
+                        } else {
+                            myAllocTraits::construct(mAlloc, out, *first);
+                        }
+                    }
+                } catch (...) {
+                    destroyRange(dst, out);
+                    throw;
+                }
+            }
+
+            void releaseHeap() noexcept {
+                if (!isInline()) myAllocTraits::deallocate(mAlloc, mElems, mCap);
+                mElems = inlineBuffer();
+                mCap = N;
+            }
+
+            void replaceStorage(T* newElems, sizeType newCap) noexcept {
+                destroyRange(mElems, mElems + mSize);
+                if (!isInline()) myAllocTraits::deallocate(mAlloc, mElems, mCap);
+                mElems = newElems;
+                mCap = newCap;
+            }
+
+            void reallocate(sizeType newCap) {
+                T* newElems = newCap <= N ? inlineBuffer() : myAllocTraits::allocate(mAlloc, newCap);
+                if (newElems == mElems) return;
+                try {
+                    relocate(mElems, mElems + mSize, newElems);
+                } catch (...) {
+                    if (newElems != inlineBuffer()) myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                    throw;
+                }
+                replaceStorage(newElems, newCap < N ? N : newCap);
+            }
+
+            // Heap buffers are stolen outright; inline elements have to be moved one by one.
+            void takeFrom(smallVector& other) {
+                if (other.isInline()) {
+                    for (; mSize < other.mSize; ++mSize) {
+                        myAllocTraits::construct(mAlloc, mElems + mSize, std::move(other.mElems[mSize]));
+                    }
+                    other.clear();
+                } else {
+                    mElems = goose::exchange(other.mElems, other.inlineBuffer());
+                    mSize = goose::exchange(other.mSize, 0);
+                    mCap = goose::exchange(other.mCap, N);
+                }
+            }
+        private:
+            alignas(T) std::byte mInline[sizeof(T) * N];
+            T* mElems{inlineBuffer()};
+            sizeType mSize{0};
+            sizeType mCap{N};
+            Alloc mAlloc;
+    };
+
+    template<typename T, size_t N, typename Alloc>
+    void swap(smallVector<T, N, Alloc>& lhs, smallVector<T, N, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,402 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "span.hpp"
+#include "utility.hpp"
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace goose {
+    // Structure-of-arrays vector: every field of the logical element lives in its own contiguous
+    // column, allocated through Alloc rebound to that field's type. Rows are read and written
+    // through tuples of references; column<I>() hands out a span for loops that only need one field.
+    template<typename Alloc, typename... Ts>
+    struct basicSoaVector {
+        static_assert(sizeof...(Ts) > 0, "soaVector needs at least one column");
+        private:
+            static constexpr size_t growthFactor = 2;
+            static constexpr size_t columnCount = sizeof...(Ts);
+            using indices = std::index_sequence_for<Ts...>;
+            using columnsType = std::tuple<Ts*...>;
+
+            template<size_t I>
+            using columnType = std::tuple_element_t<I, std::tuple<Ts...>>;
+            template<typename T>
+            using columnAlloc = typename allocatorTraits<Alloc>::template rebindAlloc<T>;
+            template<typename T>
+            using columnTraits = allocatorTraits<columnAlloc<T>>;
+            template<typename T>
+            static constexpr bool moveRelocates = std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+            template<typename T>
+            static constexpr bool neverMove = false;
+        public:
+            using valueType = std::tuple<Ts...>;
+            using reference = std::tuple<Ts&...>;
+            using constReference = std::tuple<const Ts&...>;
+            using sizeType = size_t;
+            using differenceType = std::ptrdiff_t;
+            using allocatorType = Alloc;
+
+            // Random access over rows. Dereferencing yields a tuple of references into the columns
+            // by value, so algorithms that need real references to elements will not accept it.
+            template<bool Const>
+            struct basicIterator {
+                public:
+                    using valueType = std::tuple<Ts...>;
+                    using differenceType = std::ptrdiff_t;
+                    using reference = conditional<Const, std::tuple<const Ts&...>, std::tuple<Ts&...>>;
+                    using iteratorCategory = randomAccessIteratorTag;
+
+                    struct pointer {
+                        reference row;
+                        reference* operator->() noexcept { return &row; }
+                    };
+                private:
+                    using columns = conditional<Const, std::tuple<const Ts*...>, std::tuple<Ts*...>>;
+                public:
+                    basicIterator() = default;
+                    basicIterator(const columns& cols, differenceType index) noexcept : mColumns{cols}, mIndex{index} {}
+                    template<bool WasConst, typename = enableIfT<Const && !WasConst>>
+                    basicIterator(const basicIterator<WasConst>& other) noexcept : mColumns{other.mColumns}, mIndex{other.mIndex} {}
+                public:
+                    reference operator*() const noexcept { return rowAt(mIndex, indices{}); }
+                    pointer operator->() const noexcept { return {**this}; }
+                    reference operator[](differenceType n) const noexcept { return rowAt(mIndex + n, indices{}); }
+
+                    basicIterator& operator++() noexcept { ++mIndex; return *this; }
+                    basicIterator operator++(int) noexcept { auto tmp = *this; ++mIndex; return tmp; }
+                    basicIterator& operator--() noexcept { --mIndex; return *this; }
+                    basicIterator operator--(int) noexcept { auto tmp = *this; --mIndex; return tmp; }
+                    basicIterator& operator+=(differenceType n) noexcept { mIndex += n; return *this; }
+                    basicIterator& operator-=(differenceType n) noexcept { mIndex -= n; return *this; }
+
+                    friend basicIterator operator+(basicIterator it, differenceType n) noexcept { return it += n; }
+                    friend basicIterator operator+(differenceType n, basicIterator it) noexcept { return it += n; }
+                    friend basicIterator operator-(basicIterator it, differenceType n) noexcept { return it -= n; }
+                    friend differenceType operator-(const basicIterator& lhs, const basicIterator& rhs) noexcept { return lhs.mIndex - rhs.mIndex; }
+
+                    friend bool operator==(const basicIterator& lhs, const basicIterator& rhs) noexcept { return lhs.mIndex == rhs.mIndex; }
+                    friend bool operator!=(const basicIterator& lhs, const basicIterator& rhs) noexcept { return lhs.mIndex != rhs.mIndex; }
+                    friend bool operator<(const basicIterator& lhs, const basicIterator& rhs) noexcept { return lhs.mIndex < rhs.mIndex; }
+                    friend bool operator>(const basicIterator& lhs, const basicIterator& rhs) noexcept { return lhs.mIndex > rhs.mIndex; }
+                    friend bool operator<=(const basicIterator& lhs, const basicIterator& rhs) noexcept { return lhs.mIndex <= rhs.mIndex; }
+                    friend bool operator>=(const basicIterator& lhs, const basicIterator& rhs) noexcept { return lhs.mIndex >= rhs.mIndex; }
+                private:
+                    template<size_t... Is>
+                    reference rowAt(differenceType index, std::index_sequence<Is...>) const noexcept {
+                        return reference(std::get<Is>(mColumns)[index]...);
+                    }
+
+                    template<bool> friend struct basicIterator;
+
+                    columns mColumns{};
+                    differenceType mIndex{0};
+            };
+
+            using iterator = basicIterator<false>;
+            using constIterator = basicIterator<true>;
+        public:
+            basicSoaVector() = default;
+            explicit basicSoaVector(const Alloc& alloc) : mAlloc{alloc} {}
+
+            explicit basicSoaVector(sizeType count, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
+                resize(count);
+            }
+
+            basicSoaVector(const basicSoaVector& other) : mAlloc{other.mAlloc} {
+                if (other.mSize == 0) return;
+                mColumns = allocateColumns(other.mSize);
+                try {
+                    transferColumns<neverMove<Ts>...>(other.mColumns, mColumns, other.mSize, indices{});
+                } catch (...) {
+                    deallocateColumns(mColumns, other.mSize, indices{});
+                    throw;
+                }
+                mSize = other.mSize;
+                mCap = other.mSize;
+            }
+
+            basicSoaVector(basicSoaVector&& other) noexcept
+                : mColumns{goose::exchange(other.mColumns, columnsType{})}, mSize{goose::exchange(other.mSize, 0)},
+                  mCap{goose::exchange(other.mCap, 0)}, mAlloc{std::move(other.mAlloc)} {}
+
+            basicSoaVector& operator=(const basicSoaVector& other) {
+                if (this == &other) return *this;
+                basicSoaVector copy(other);
+                swap(copy);
+                return *this;
+            }
+
+            basicSoaVector& operator=(basicSoaVector&& other) noexcept {
+                if (this == &other) return *this;
+                releaseStorage();
+                mColumns = goose::exchange(other.mColumns, columnsType{});
+                mSize = goose::exchange(other.mSize, 0);
+                mCap = goose::exchange(other.mCap, 0);
+                mAlloc = std::move(other.mAlloc);
+                return *this;
+            }
+
+            ~basicSoaVector() { releaseStorage(); }
+        public:
+            reference operator[](sizeType pos) noexcept { return begin()[pos]; }
+            constReference operator[](sizeType pos) const noexcept { return cbegin()[pos]; }
+            reference front() noexcept { return (*this)[0]; }
+            constReference front() const noexcept { return (*this)[0]; }
+            reference back() noexcept { return (*this)[mSize - 1]; }
+            constReference back() const noexcept { return (*this)[mSize - 1]; }
+
+            template<size_t I>
+            span<columnType<I>> column() noexcept { return {std::get<I>(mColumns), mSize}; }
+            template<size_t I>
+            span<const columnType<I>> column() const noexcept { return {std::get<I>(mColumns), mSize}; }
+
+            iterator begin() noexcept { return {mColumns, 0}; }
+            iterator end() noexcept { return {mColumns, static_cast<differenceType>(mSize)}; }
+            constIterator begin() const noexcept { return cbegin(); }
+            constIterator end() const noexcept { return cend(); }
+            constIterator cbegin() const noexcept { return {constColumns(indices{}), 0}; }
+            constIterator cend() const noexcept { return {constColumns(indices{}), static_cast<differenceType>(mSize)}; }
+        public:
+            sizeType size() const noexcept { return mSize; }
+            sizeType capacity() const noexcept { return mCap; }
+            bool empty() const noexcept { return mSize == 0; }
+
+            void reserve(sizeType newCap) {
+                if (newCap > mCap) reallocate(newCap);
+            }
+
+            void shrinkToFit() {
+                if (mSize == mCap) return;
+                if (mSize == 0) {
+                    releaseStorage();
+                    return;
+                }
+                reallocate(mSize);
+            }
+
+            void clear() noexcept {
+                destroyRows(mColumns, 0, mSize, indices{});
+                mSize = 0;
+            }
+
+            void swap(basicSoaVector& other) noexcept {
+                std::swap(mColumns, other.mColumns);
+                goose::swap(mSize, other.mSize);
+                goose::swap(mCap, other.mCap);
+                std::swap(mAlloc, other.mAlloc);
+            }
+        public:
+            // Takes one value per column. If the columns have to grow, the new row is built in the
+            // new storage before the old rows move, so values may alias elements of this vector.
+            template<typename... Us, typename = enableIfT<sizeof...(Us) == columnCount>>
+            reference emplaceBack(Us&&... values) {
+                if (mSize == mCap) {
+                    sizeType newCap = nextCapacity(mSize + 1);
+                    columnsType newColumns = allocateColumns(newCap);
+                    try {
+                        constructRow(newColumns, mSize, indices{}, std::forward<Us>(values)...);
+                    } catch (...) {
+                        deallocateColumns(newColumns, newCap, indices{});
+                        throw;
+                    }
+                    try {
+                        transferColumns<moveRelocates<Ts>...>(mColumns, newColumns, mSize, indices{});
+                    } catch (...) {
+                        destroyRows(newColumns, mSize, mSize + 1, indices{});
+                        deallocateColumns(newColumns, newCap, indices{});
+                        throw;
+                    }
+                    replaceStorage(newColumns, newCap);
+                } else {
+                    constructRow(mColumns, mSize, indices{}, std::forward<Us>(values)...);
+                }
+                ++mSize;
+                return back();
+            }
+
+            void pushBack(const valueType& row) {
+                std::apply([this](const auto&... values) { emplaceBack(values...); }, row);
+            }
+
+            void pushBack(valueType&& row) {
+                std::apply([this](auto&... values) { emplaceBack(std::move(values)...); }, row);
+            }
+
+            void popBack() noexcept {
+                --mSize;
+                destroyRows(mColumns, mSize, mSize + 1, indices{});
+            }
+
+            // New rows are value-initialized.
+            void resize(sizeType count) {
+                if (count <= mSize) {
+                    destroyRows(mColumns, count, mSize, indices{});
+                    mSize = count;
+                    return;
+                }
+                reserve(count);
+                for (; mSize < count; ++mSize) constructRow(mColumns, mSize, indices{});
+            }
+        private:
+            sizeType nextCapacity(sizeType required) const noexcept {
+                sizeType grown = mCap * growthFactor;
+                return grown < required ? required : grown;
+            }
+
+            template<size_t... Is>
+            std::tuple<const Ts*...> constColumns(std::index_sequence<Is...>) const noexcept {
+                return {std::get<Is>(mColumns)...};
+            }
+
+            template<size_t I>
+            auto allocatorFor() const { return columnAlloc<columnType<I>>(mAlloc); }
+
+            // All columns are allocated up front, so a failure leaves nothing half grown.
+            columnsType allocateColumns(sizeType count) {
+                columnsType columns{};
+                try {
+                    allocateEach(columns, count, indices{});
+                } catch (...) {
+                    deallocateColumns(columns, count, indices{});
+                    throw;
+                }
+                return columns;
+            }
+
+            template<size_t... Is>
+            void allocateEach(columnsType& columns, sizeType count, std::index_sequence<Is...>) {
+                ((std::get<Is>(columns) = allocateColumn<Is>(count)), ...);
+            }
+
+            template<size_t I>
+            columnType<I>* allocateColumn(sizeType count) {
+                auto alloc = allocatorFor<I>();
+                return columnTraits<columnType<I>>::allocate(alloc, count);
+            }
+
+            template<size_t... Is>
+            void deallocateColumns(const columnsType& columns, sizeType count, std::index_sequence<Is...>) noexcept {
+                (deallocateColumn<Is>(std::get<Is>(columns), count), ...);
+            }
+
+            template<size_t I>
+            void deallocateColumn(columnType<I>* column, sizeType count) noexcept {
+                if (!column) return;
+                auto alloc = allocatorFor<I>();
+                columnTraits<columnType<I>>::deallocate(alloc, column, count);
+            }
+
+            template<size_t... Is>
+            void destroyRows(const columnsType& columns, sizeType first, sizeType last, std::index_sequence<Is...>) noexcept {
+                (destroyColumn<Is>(std::get<Is>(columns), first, last), ...);
+            }
+
+            template<size_t I>
+            void destroyColumn(columnType<I>* column, sizeType first, sizeType last) noexcept {
+                using T = columnType<I>;
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    auto alloc = allocatorFor<I>();
+                    for (sizeType i = first; i < last; ++i) columnTraits<T>::destroy(alloc, column + i);
+                }
+            }
+
+            // Constructs one field per column at index, unwinding the fields already built if one throws.
+            template<size_t... Is, typename... Us>
+            void constructRow(const columnsType& columns, sizeType index, std::index_sequence<Is...>, Us&&... values) {
+                size_t built = 0;
+                try {
+                    if constexpr (sizeof...(Us) == 0) {
+                        ((constructField<Is>(columns, index), ++built), ...);
+                    } else {
+                        ((constructField<Is>(columns, index, std::forward<Us>(values)), ++built), ...);
+                    }
+                } catch (...) {
+                    ((Is < built ? destroyColumn<Is>(std::get<Is>(columns), index, index + 1) : void()), ...);
+                    throw;
+                }
+            }
+
+            template<size_t I, typename... Args>
+            void constructField(const columnsType& columns, sizeType index, Args&&... args) {
+                auto alloc = allocatorFor<I>();
+                columnTraits<columnType<I>>::construct(alloc, std::get<I>(columns) + index, std::forward<Args>(args)...);
+            }
+
+            // Builds count rows of to from from. Columns whose Move flag is false are copied first;
+            // only once every copy has succeeded are the remaining columns moved, and those moves
+            // cannot throw. A failure therefore leaves from untouched and to empty.
+            template<bool... Move, size_t... Is>
+            void transferColumns(const columnsType& from, const columnsType& to, sizeType count, std::index_sequence<Is...>) {
+                bool copied[columnCount]{};
+                try {
+                    ((Move ? void() : (copyColumn<Is>(std::get<Is>(from), std::get<Is>(to), count), void(copied[Is] = true))), ...);
+                } catch (...) {
+                    ((copied[Is] ? destroyColumn<Is>(std::get<Is>(to), 0, count) : void()), ...);
+                    throw;
+                }
+                ((Move ? moveColumn<Is>(std::get<Is>(from), std::get<Is>(to), count) : void()), ...);
+            }
+
+            template<size_t I>
+            void copyColumn(const columnType<I>* from, columnType<I>* to, sizeType count) {
+                using T = columnType<I>;
+                auto alloc = allocatorFor<I>();
+                sizeType built = 0;
+                try {
+                    for (; built < count; ++built) columnTraits<T>::construct(alloc, to + built, from[built]);
+                } catch (...) {
+                    destroyColumn<I>(to, 0, built);
+                    throw;
+                }
+            }
+
+            template<size_t I>
+            void moveColumn(columnType<I>* from, columnType<I>* to, sizeType count) noexcept {
+                using T = columnType<I>;
+                auto alloc = allocatorFor<I>();
+                for (sizeType i = 0; i < count; ++i) columnTraits<T>::construct(alloc, to + i, std::move(from[i]));
+            }
+
+            void replaceStorage(const columnsType& newColumns, sizeType newCap) noexcept {
+                destroyRows(mColumns, 0, mSize, indices{});
+                if (mCap) deallocateColumns(mColumns, mCap, indices{});
+                mColumns = newColumns;
+                mCap = newCap;
+            }
+
+            void reallocate(sizeType newCap) {
+                columnsType newColumns = allocateColumns(newCap);
+                try {
+                    transferColumns<moveRelocates<Ts>...>(mColumns, newColumns, mSize, indices{});
+                } catch (...) {
+                    deallocateColumns(newColumns, newCap, indices{});
+                    throw;
+                }
+                replaceStorage(newColumns, newCap);
+            }
+
+            void releaseStorage() noexcept {
+                clear();
+                if (mCap) deallocateColumns(mColumns, mCap, indices{});
+                mColumns = columnsType{};
+                mCap = 0;
+            }
+        private:
+            columnsType mColumns{};
+            sizeType mSize{0};
+            sizeType mCap{0};
+            Alloc mAlloc;
+    };
+
+    template<typename... Ts>
+    using soaVector = basicSoaVector<allocator<char>, Ts...>;
+
+    template<typename Alloc, typename... Ts>
+    void swap(basicSoaVector<Alloc, Ts...>& lhs, basicSoaVector<Alloc, Ts...>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,666 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace goose {
+    namespace _implementation {
+        // The comparison the argument-less overloads use. Sorting with it (or std::less) lets
+        // the arithmetic fast paths below kick in.
+        struct _lessThan {
+            template<typename A, typename B>
+            constexpr bool operator()(const A& a, const B& b) const { return a < b; }
+        };
+
+        template<typename Compare, typename T>
+        inline constexpr bool _isNaturalOrder = std::is_same_v<Compare, _lessThan> || std::is_same_v<Compare, std::less<>>
+                                                || std::is_same_v<Compare, std::less<T>>;
+
+        // Small trivially copyable values are cheap to copy around, so partitioning can buffer
+        // comparison results as indices instead of branching on them. Small records sorted by a
+        // key gain as much from this as plain numbers do.
+        template<typename T>
+        inline constexpr bool _branchlessSort = std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void*);
+
+        // Keys sort() hands to radix sort. 64-bit keys need all eight passes and beat branchless
+        // pdqsort only over a narrow range of sizes, so they are radix sorted only on request.
+        template<typename T>
+        inline constexpr bool _radixSortable = ((std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_enum_v<T>
+                                                || std::is_same_v<T, float>) && sizeof(T) <= 4;
+
+        inline constexpr std::ptrdiff_t _insertionSortThreshold = 24;
+        inline constexpr std::ptrdiff_t _nintherThreshold = 128;
+        inline constexpr size_t _partialInsertionSortLimit = 8;
+        inline constexpr size_t _partitionBlockSize = 64;
+        // Below this many elements pdqsort beats the fixed cost of the radix passes.
+        inline constexpr size_t _radixSortThreshold = 1024;
+
+        template<class It>
+        constexpr void _iterSwap(It a, It b) {
+            auto tmp = std::move(*a);
+            *a = std::move(*b);
+            *b = std::move(tmp);
+        }
+
+        template<class It, class Compare>
+        constexpr void _sort2(It a, It b, Compare& comp) {
+            if (comp(*b, *a)) _iterSwap(a, b);
+        }
+
+        template<class It, class Compare>
+        constexpr void _sort3(It a, It b, It c, Compare& comp) {
+            _sort2(a, b, comp);
+            _sort2(b, c, comp);
+            _sort2(a, b, comp);
+        }
+
+        // Only used for arithmetic values, where both selects become conditional moves.
+        template<class It, class Compare>
+        constexpr void _compareExchange(It a, It b, Compare& comp) {
+            auto x = *a;
+            auto y = *b;
+            bool swap = comp(y, x);
+            *a = swap ? y : x;
+            *b = swap ? x : y;
+        }
+
+        // Size-optimal sorting networks for up to eight elements: a fixed sequence of
+        // compare-exchanges with no data-dependent branches.
+        template<class It, class Compare>
+        constexpr bool _sortingNetwork(It first, std::ptrdiff_t length, Compare& comp) {
+            auto cx = [&](int i, int j) { _compareExchange(first + i, first + j, comp); };
+            switch (length) {
+                case 0:
+                case 1:
+                    return true;
+                case 2:
+                    cx(0, 1);
+                    return true;
+                case 3:
+                    cx(0, 2); cx(0, 1); cx(1, 2);
+                    return true;
+                case 4:
+                    cx(0, 2); cx(1, 3); cx(0, 1); cx(2, 3); cx(1, 2);
+                    return true;
+                case 5:
+                    cx(0, 3); cx(1, 4); cx(0, 2); cx(1, 3); cx(0, 1); cx(2, 4); cx(1, 2); cx(3, 4); cx(2, 3);
+                    return true;
+                case 6:
+                    cx(0, 5); cx(1, 3); cx(2, 4); cx(1, 2); cx(3, 4); cx(0, 3);
+                    cx(2, 5); cx(0, 1); cx(2, 3); cx(4, 5); cx(1, 2); cx(3, 4);
+                    return true;
+                case 7:
+                    cx(0, 6); cx(2, 3); cx(4, 5); cx(0, 2); cx(1, 4); cx(3, 6); cx(0, 1); cx(2, 5);
+                    cx(3, 4); cx(1, 2); cx(4, 6); cx(2, 3); cx(4, 5); cx(1, 2); cx(3, 4); cx(5, 6);
+                    return true;
+                case 8:
+                    cx(0, 2); cx(1, 3); cx(4, 6); cx(5, 7); cx(0, 4); cx(1, 5); cx(2, 6); cx(3, 7); cx(0, 1); cx(2, 3);
+                    cx(4, 5); cx(6, 7); cx(2, 4); cx(3, 5); cx(1, 4); cx(3, 6); cx(1, 2); cx(3, 4); cx(5, 6);
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        template<class It, class Compare>
+        constexpr void _insertionSort(It first, It last, Compare& comp) {
+            if (first == last) return;
+            for (It i = first + 1; i != last; ++i) {
+                if (!comp(*i, *(i - 1))) continue;
+                auto value = std::move(*i);
+                It hole = i;
+                do {
+                    *hole = std::move(*(hole - 1));
+                    --hole;
+                } while (hole != first && comp(value, *(hole - 1)));
+                *hole = std::move(value);
+            }
+        }
+
+        // Needs an element before first that is not greater than anything in [first, last).
+        template<class It, class Compare>
+        constexpr void _unguardedInsertionSort(It first, It last, Compare& comp) {
+            if (first == last) return;
+            for (It i = first + 1; i != last; ++i) {
+                if (!comp(*i, *(i - 1))) continue;
+                auto value = std::move(*i);
+                It hole = i;
+                do {
+                    *hole = std::move(*(hole - 1));
+                    --hole;
+                } while (comp(value, *(hole - 1)));
+                *hole = std::move(value);
+            }
+        }
+
+        // Insertion sort that gives up after moving a handful of elements, for ranges that are
+        // probably sorted already. Returns whether it finished.
+        template<class It, class Compare>
+        constexpr bool _partialInsertionSort(It first, It last, Compare& comp) {
+            if (first == last) return true;
+            size_t moved = 0;
+            for (It i = first + 1; i != last; ++i) {
+                if (comp(*i, *(i - 1))) {
+                    auto value = std::move(*i);
+                    It hole = i;
+                    do {
+                        *hole = std::move(*(hole - 1));
+                        --hole;
+                    } while (hole != first && comp(value, *(hole - 1)));
+                    *hole = std::move(value);
+                    moved += static_cast<size_t>(i - hole);
+                }
+                if (moved > _partialInsertionSortLimit) return false;
+            }
+            return true;
+        }
+
+        template<class It, class Compare>
+        constexpr void _siftDown(It first, std::ptrdiff_t length, std::ptrdiff_t root, Compare& comp) {
+            auto value = std::move(first[root]);
+            for (std::ptrdiff_t child = 2 * root + 1; child < length; child = 2 * root + 1) {
+                if (child + 1 < length && comp(first[child], first[child + 1])) ++child;
+                if (!comp(value, first[child])) break;
+                first[root] = std::move(first[child]);
+                root = child;
+            }
+            first[root] = std::move(value);
+        }
+
+        template<class It, class Compare>
+        constexpr void _makeHeap(It first, std::ptrdiff_t length, Compare& comp) {
+            for (std::ptrdiff_t root = length / 2; root-- > 0;) _siftDown(first, length, root, comp);
+        }
+
+        template<class It, class Compare>
+        constexpr void _sortHeap(It first, std::ptrdiff_t length, Compare& comp) {
+            for (std::ptrdiff_t end = length - 1; end > 0; --end) {
+                _iterSwap(first, first + end);
+                _siftDown(first, end, 0, comp);
+            }
+        }
+
+        template<class It, class Compare>
+        constexpr void _heapSort(It first, It last, Compare& comp) {
+            _makeHeap(first, last - first, comp);
+            _sortHeap(first, last - first, comp);
+        }
+
+        template<class It>
+        struct _partitionResult {
+            It pivot;
+            bool alreadyPartitioned;
+        };
+
+        // Partitions [first, last) around *first: smaller elements end up left of the returned
+        // pivot position, the rest right of it. The median-of-three that picked the pivot
+        // guarantees an element not less than it, so the forward scan needs no bound.
+        template<class It, class Compare>
+        constexpr _partitionResult<It> _partitionRight(It first, It last, Compare& comp) {
+            auto pivot = std::move(*first);
+            It lo = first;
+            It hi = last;
+            while (comp(*++lo, pivot)) {}
+            if (lo - 1 == first) {
+                while (lo < hi && !comp(*--hi, pivot)) {}
+            } else {
+                while (!comp(*--hi, pivot)) {}
+            }
+            bool alreadyPartitioned = lo >= hi;
+            while (lo < hi) {
+                _iterSwap(lo, hi);
+                while (comp(*++lo, pivot)) {}
+                while (!comp(*--hi, pivot)) {}
+            }
+            It pivotPos = lo - 1;
+            *first = std::move(*pivotPos);
+            *pivotPos = std::move(pivot);
+            return {pivotPos, alreadyPartitioned};
+        }
+
+        // Block partition after Edelkamp and Weiss's BlockQuicksort: compare a block of
+        // elements from each end, record which are on the wrong side as byte offsets, then swap
+        // those in bulk. The comparisons only feed array indices, so there is nothing for the
+        // branch predictor to miss. Runtime only: constant evaluation takes _partitionRight.
+        template<class It, class Compare>
+        _partitionResult<It> _partitionRightBranchless(It first, It last, Compare& comp) {
+            auto pivot = std::move(*first);
+            It lo = first;
+            It hi = last;
+            while (comp(*++lo, pivot)) {}
+            if (lo - 1 == first) {
+                while (lo < hi && !comp(*--hi, pivot)) {}
+            } else {
+                while (!comp(*--hi, pivot)) {}
+            }
+            bool alreadyPartitioned = lo >= hi;
+            if (!alreadyPartitioned) {
+                _iterSwap(lo, hi);
+                ++lo;
+
+                alignas(cacheLineSize) unsigned char offsetsLeft[_partitionBlockSize];
+                alignas(cacheLineSize) unsigned char offsetsRight[_partitionBlockSize];
+                It baseLeft = lo;
+                It baseRight = hi;
+                size_t countLeft = 0, countRight = 0, startLeft = 0, startRight = 0;
+                while (lo < hi) {
+                    // Refill whichever offset buffers are empty, splitting what is left between
+                    // them once fewer than two blocks remain.
+                    auto unknown = static_cast<size_t>(hi - lo);
+                    size_t splitLeft = countLeft == 0 ? (countRight == 0 ? unknown / 2 : unknown) : 0;
+                    size_t splitRight = countRight == 0 ? unknown - splitLeft : 0;
+                    if (splitLeft > _partitionBlockSize) splitLeft = _partitionBlockSize;
+                    if (splitRight > _partitionBlockSize) splitRight = _partitionBlockSize;
+                    for (size_t i = 0; i < splitLeft; ++i) {
+                        offsetsLeft[countLeft] = static_cast<unsigned char>(i);
+                        countLeft += !comp(*lo, pivot);
+                        ++lo;
+                    }
+                    for (size_t i = 0; i < splitRight;) {
+                        offsetsRight[countRight] = static_cast<unsigned char>(++i);
+                        countRight += comp(*--hi, pivot);
+                    }
+
+                    // Swap as many misplaced pairs as both buffers hold. A cycle of moves instead
+                    // of swaps saves a third of the writes when the counts differ.
+                    size_t count = countLeft < countRight ? countLeft : countRight;
+                    const unsigned char* left = offsetsLeft + startLeft;
+                    const unsigned char* right = offsetsRight + startRight;
+                    if (countLeft == countRight) {
+                        for (size_t i = 0; i < count; ++i) _iterSwap(baseLeft + left[i], baseRight - right[i]);
+                    } else if (count > 0) {
+                        It l = baseLeft + left[0];
+                        It r = baseRight - right[0];
+                        auto tmp = std::move(*l);
+                        *l = std::move(*r);
+                        for (size_t i = 1; i < count; ++i) {
+                            l = baseLeft + left[i];
+                            *r = std::move(*l);
+                            r = baseRight - right[i];
+                            *l = std::move(*r);
+                        }
+                        *r = std::move(tmp);
+                    }
+                    countLeft -= count;
+                    countRight -= count;
+                    startLeft += count;
+                    startRight += count;
+                    if (countLeft == 0) {
+                        startLeft = 0;
+                        baseLeft = lo;
+                    }
+                    if (countRight == 0) {
+                        startRight = 0;
+                        baseRight = hi;
+                    }
+                }
+
+                // One side may still hold misplaced elements; move them to the boundary.
+                if (countLeft) {
+                    const unsigned char* left = offsetsLeft + startLeft;
+                    while (countLeft--) _iterSwap(baseLeft + left[countLeft], --hi);
+                    lo = hi;
+                }
+                if (countRight) {
+                    const unsigned char* right = offsetsRight + startRight;
+                    while (countRight--) {
+                        _iterSwap(baseRight - right[countRight], lo);
+                        ++lo;
+                    }
+                }
+            }
+            It pivotPos = lo - 1;
+            *first = std::move(*pivotPos);
+            *pivotPos = std::move(pivot);
+            return {pivotPos, alreadyPartitioned};
+        }
+
+        // Puts elements equal to the pivot on its left. Used when the pivot equals the element
+        // just before the range, which means the whole left side is one run of equal keys.
+        template<class It, class Compare>
+        constexpr It _partitionLeft(It first, It last, Compare& comp) {
+            auto pivot = std::move(*first);
+            It lo = first;
+            It hi = last;
+            while (comp(pivot, *--hi)) {}
+            if (hi + 1 == last) {
+                while (lo < hi && !comp(pivot, *++lo)) {}
+            } else {
+                while (!comp(pivot, *++lo)) {}
+            }
+            while (lo < hi) {
+                _iterSwap(lo, hi);
+                while (comp(pivot, *--hi)) {}
+                while (!comp(pivot, *++lo)) {}
+            }
+            *first = std::move(*hi);
+            *hi = std::move(pivot);
+            return hi;
+        }
+
+        // Orson Peters' pattern-defeating quicksort. Beyond introsort it detects ranges that are
+        // already partitioned and finishes them with a cheap insertion pass, groups runs of keys
+        // equal to an earlier pivot in one step, and breaks up adversarial patterns by shuffling a
+        // few elements after each badly unbalanced partition. Too many of those and it falls back
+        // to heapsort, which bounds the worst case at O(n log n).
+        template<bool Branchless, class It, class Compare>
+        constexpr void _pdqsort(It first, It last, Compare& comp, int badAllowed, bool leftmost) {
+            while (true) {
+                std::ptrdiff_t size = last - first;
+                if (size < _insertionSortThreshold) {
+                    if constexpr (Branchless && std::is_arithmetic_v<typename iteratorTraits<It>::valueType>) {
+                        if (_sortingNetwork(first, size, comp)) return;
+                    }
+                    if (leftmost) {
+                        _insertionSort(first, last, comp);
+                    } else {
+                        _unguardedInsertionSort(first, last, comp);
+                    }
+                    return;
+                }
+
+                std::ptrdiff_t half = size / 2;
+                if (size > _nintherThreshold) {
+                    _sort3(first, first + half, last - 1, comp);
+                    _sort3(first + 1, first + (half - 1), last - 2, comp);
+                    _sort3(first + 2, first + (half + 1), last - 3, comp);
+                    _sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                    _iterSwap(first, first + half);
+                } else {
+                    _sort3(first + half, first, last - 1, comp);
+                }
+
+                if (!leftmost && !comp(*(first - 1), *first)) {
+                    first = _partitionLeft(first, last, comp) + 1;
+                    continue;
+                }
+
+                _partitionResult<It> result{first, false};
+                if (Branchless && !_isConstantEvaluated()) {
+                    result = _partitionRightBranchless(first, last, comp);
+                } else {
+                    result = _partitionRight(first, last, comp);
+                }
+                It pivotPos = result.pivot;
+
+                std::ptrdiff_t leftSize = pivotPos - first;
+                std::ptrdiff_t rightSize = last - (pivotPos + 1);
+                if (leftSize < size / 8 || rightSize < size / 8) {
+                    if (--badAllowed == 0) {
+                        _heapSort(first, last, comp);
+                        return;
+                    }
+                    if (leftSize >= _insertionSortThreshold) {
+                        _iterSwap(first, first + leftSize / 4);
+                        _iterSwap(pivotPos - 1, pivotPos - leftSize / 4);
+                        if (leftSize > _nintherThreshold) {
+                            _iterSwap(first + 1, first + (leftSize / 4 + 1));
+                            _iterSwap(first + 2, first + (leftSize / 4 + 2));
+                            _iterSwap(pivotPos - 2, pivotPos - (leftSize / 4 + 1));
+                            _iterSwap(pivotPos - 3, pivotPos - (leftSize / 4 + 2));
+                        }
+                    }
+                    if (rightSize >= _insertionSortThreshold) {
+                        _iterSwap(pivotPos + 1, pivotPos + (1 + rightSize / 4));
+                        _iterSwap(last - 1, last - rightSize / 4);
+                        if (rightSize > _nintherThreshold) {
+                            _iterSwap(pivotPos + 2, pivotPos + (2 + rightSize / 4));
+                            _iterSwap(pivotPos + 3, pivotPos + (3 + rightSize / 4));
+                            _iterSwap(last - 2, last - (1 + rightSize / 4));
+                            _iterSwap(last - 3, last - (2 + rightSize / 4));
+                        }
+                    }
+                } else if (result.alreadyPartitioned && _partialInsertionSort(first, pivotPos, comp)
+                           && _partialInsertionSort(pivotPos + 1, last, comp)) {
+                    return;
+                }
+
+                _pdqsort<Branchless>(first, pivotPos, comp, badAllowed, leftmost);
+                first = pivotPos + 1;
+                leftmost = false;
+            }
+        }
+
+        // Maps a key to an unsigned integer with the same order, so radix passes can treat
+        // every key type as plain bits. Negative floats have all their bits flipped and the rest
+        // only the sign bit, which also orders -0.0 before 0.0.
+        template<typename K>
+        auto _radixBits(K key) noexcept {
+            if constexpr (std::is_enum_v<K>) {
+                return _radixBits(static_cast<std::underlying_type_t<K>>(key));
+            } else if constexpr (std::is_integral_v<K>) {
+                using U = std::make_unsigned_t<K>;
+                U bits = static_cast<U>(key);
+                if constexpr (std::is_signed_v<K>) bits ^= U{1} << (sizeof(K) * 8 - 1);
+                return bits;
+            } else {
+                using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+                U bits;
+                std::memcpy(&bits, &key, sizeof(bits));
+                U sign = U{1} << (sizeof(K) * 8 - 1);
+                return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+            }
+        }
+
+        // LSD radix sort on 8-bit digits. One pass over the data builds every digit's histogram,
+        // digits that are the same for all keys are skipped, and the rest scatter back and forth
+        // between data and one scratch buffer. Stable.
+        template<typename T, typename Key, typename Alloc>
+        void _radixSort(T* data, size_t length, const Key& key, const Alloc& alloc) {
+            static_assert(std::is_trivially_copyable_v<T>, "radixSort moves elements as raw bytes");
+            using bitsType = decltype(_radixBits(key(*data)));
+            constexpr size_t passes = sizeof(bitsType);
+            if (length < 2) return;
+
+            size_t counts[passes][256] = {};
+            for (size_t i = 0; i < length; ++i) {
+                bitsType bits = _radixBits(key(data[i]));
+                for (size_t pass = 0; pass < passes; ++pass) ++counts[pass][(bits >> (8 * pass)) & 0xFF];
+            }
+
+            using scratchAlloc = typename allocatorTraits<Alloc>::template rebindAlloc<T>;
+            using scratchTraits = allocatorTraits<scratchAlloc>;
+            scratchAlloc scratch(alloc);
+            T* buffer = scratchTraits::allocate(scratch, length);
+            T* from = data;
+            T* to = buffer;
+            for (size_t pass = 0; pass < passes; ++pass) {
+                size_t* count = counts[pass];
+                if (count[(_radixBits(key(from[0])) >> (8 * pass)) & 0xFF] == length) continue;
+                size_t offsets[256];
+                size_t total = 0;
+                for (size_t digit = 0; digit < 256; ++digit) {
+                    offsets[digit] = total;
+                    total += count[digit];
+                }
+                for (size_t i = 0; i < length; ++i) {
+                    size_t digit = (_radixBits(key(from[i])) >> (8 * pass)) & 0xFF;
+                    std::memcpy(static_cast<void*>(to + offsets[digit]++), static_cast<const void*>(from + i), sizeof(T));
+                }
+                T* swap = from;
+                from = to;
+                to = swap;
+            }
+            if (from != data) std::memcpy(static_cast<void*>(data), static_cast<const void*>(from), length * sizeof(T));
+            scratchTraits::deallocate(scratch, buffer, length);
+        }
+
+        struct _identityKey {
+            template<typename T>
+            constexpr const T& operator()(const T& value) const noexcept { return value; }
+        };
+
+        template<typename It, typename Compare, typename = void>
+        inline constexpr bool _radixSortsRange = false;
+
+        template<typename It, typename Compare>
+        inline constexpr bool _radixSortsRange<It, Compare, std::enable_if_t<_contiguous<It>::value>> =
+            _radixSortable<_contiguousValue<It>> && _isNaturalOrder<Compare, _contiguousValue<It>>;
+
+        // Radix sorts [first, last) when its type and size allow, and says whether it did.
+        template<typename Compare, typename It>
+        constexpr bool _tryRadixSort(It first, It last) {
+            if constexpr (_radixSortsRange<It, Compare>) {
+                auto length = static_cast<size_t>(last - first);
+                if (!_isConstantEvaluated() && length >= _radixSortThreshold) {
+                    _radixSort(toPointer(first), length, _identityKey{}, allocator<char>());
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        inline constexpr size_t _mergeSortRun = 32;
+
+        // Merges sorted [first, middle) and [middle, last) by moving the left run into buffer.
+        // If a comparison throws, the buffered elements are moved back into the gap they left,
+        // so no element is lost.
+        template<class It, class T, class Compare>
+        void _mergeWithBuffer(It first, It middle, It last, T* buffer, Compare& comp) {
+            std::ptrdiff_t leftLength = middle - first;
+            std::ptrdiff_t built = 0;
+            try {
+                for (; built < leftLength; ++built) constructAt(buffer + built, std::move(first[built]));
+            } catch (...) {
+                for (std::ptrdiff_t i = 0; i < built; ++i) first[i] = std::move(buffer[i]);
+                for (std::ptrdiff_t i = 0; i < built; ++i) destroyAt(buffer + i);
+                throw;
+            }
+            T* left = buffer;
+            T* leftEnd = buffer + leftLength;
+            It right = middle;
+            It out = first;
+            try {
+                if constexpr (_branchlessSort<T>) {
+                    // Select and advance without a branch on the comparison.
+                    while (left != leftEnd && right != last) {
+                        bool takeRight = comp(*right, *left);
+                        *out = takeRight ? *right : *left;
+                        right += takeRight;
+                        left += !takeRight;
+                        ++out;
+                    }
+                } else {
+                    while (left != leftEnd && right != last) {
+                        if (comp(*right, *left)) {
+                            *out = std::move(*right);
+                            ++right;
+                        } else {
+                            *out = std::move(*left);
+                            ++left;
+                        }
+                        ++out;
+                    }
+                }
+                for (; left != leftEnd; ++left, ++out) *out = std::move(*left);
+            } catch (...) {
+                for (; left != leftEnd; ++left, ++out) *out = std::move(*left);
+                for (std::ptrdiff_t i = 0; i < leftLength; ++i) destroyAt(buffer + i);
+                throw;
+            }
+            for (std::ptrdiff_t i = 0; i < leftLength; ++i) destroyAt(buffer + i);
+        }
+
+        template<class It, class T, class Compare>
+        void _mergeSort(It first, It last, T* buffer, Compare& comp) {
+            std::ptrdiff_t length = last - first;
+            if (length <= static_cast<std::ptrdiff_t>(_mergeSortRun)) {
+                _insertionSort(first, last, comp);
+                return;
+            }
+            It middle = first + length / 2;
+            _mergeSort(first, middle, buffer, comp);
+            _mergeSort(middle, last, buffer, comp);
+            if (comp(*middle, *(middle - 1))) _mergeWithBuffer(first, middle, last, buffer, comp);
+        }
+    }
+
+    // Unstable sort of a random-access range. Comparison sorts use pdqsort, with block
+    // partitioning for small trivially copyable types and sorting networks for arithmetic ones.
+    // Large contiguous ranges of integers, enums or floats of up to 32 bits in natural order are
+    // radix sorted instead. Usable in constant expressions, where pdqsort is always taken.
+    template<class It, class Compare>
+    constexpr void sort(It first, It last, Compare comp) {
+        if (_implementation::_tryRadixSort<Compare>(first, last)) return;
+        using T = typename iteratorTraits<It>::valueType;
+        int badAllowed = 1;
+        for (std::ptrdiff_t length = last - first; length > 1; length >>= 1) ++badAllowed;
+        _implementation::_pdqsort<_implementation::_branchlessSort<T>>(first, last, comp, badAllowed, true);
+    }
+
+    template<class It>
+    constexpr void sort(It first, It last) {
+        goose::sort(first, last, _implementation::_lessThan{});
+    }
+
+    // Sorts so that equal elements keep their order: radix sort where sort() would use it,
+    // otherwise a merge sort over a scratch buffer of half the range from goose::allocator.
+    template<class It, class Compare>
+    void stableSort(It first, It last, Compare comp) {
+        if (_implementation::_tryRadixSort<Compare>(first, last)) return;
+        using T = typename iteratorTraits<It>::valueType;
+        auto length = static_cast<size_t>(last - first);
+        if (length <= _implementation::_mergeSortRun) {
+            _implementation::_insertionSort(first, last, comp);
+            return;
+        }
+        allocator<T> alloc;
+        size_t bufferLength = (length + 1) / 2;
+        T* buffer = alloc.allocate(bufferLength);
+        try {
+            _implementation::_mergeSort(first, last, buffer, comp);
+        } catch (...) {
+            alloc.deallocate(buffer, bufferLength);
+            throw;
+        }
+        alloc.deallocate(buffer, bufferLength);
+    }
+
+    template<class It>
+    void stableSort(It first, It last) {
+        goose::stableSort(first, last, _implementation::_lessThan{});
+    }
+
+    // Leaves the smallest middle - first elements sorted at the front; the order of the rest
+    // is unspecified. A heap of the front part is kept while scanning the tail, so the cost is
+    // O(n log k) for k = middle - first.
+    template<class It, class Compare>
+    constexpr void partialSort(It first, It middle, It last, Compare comp) {
+        std::ptrdiff_t length = middle - first;
+        if (length == 0) return;
+        _implementation::_makeHeap(first, length, comp);
+        for (It it = middle; it != last; ++it) {
+            if (comp(*it, *first)) {
+                _implementation::_iterSwap(it, first);
+                _implementation::_siftDown(first, length, 0, comp);
+            }
+        }
+        _implementation::_sortHeap(first, length, comp);
+    }
+
+    template<class It>
+    constexpr void partialSort(It first, It middle, It last) {
+        goose::partialSort(first, middle, last, _implementation::_lessThan{});
+    }
+
+    // Stable LSD radix sort of contiguous records by key(record), which must return an integer,
+    // enum, float or double. The scratch buffer, as large as the range, comes from alloc.
+    // Records are moved as raw bytes, so they must be trivially copyable.
+    template<class It, class Key, class Alloc = allocator<char>>
+    void radixSort(It first, It last, Key key, const Alloc& alloc = Alloc()) {
+        static_assert(_implementation::_contiguous<It>::value, "radixSort needs a contiguous range");
+        _implementation::_radixSort(_implementation::toPointer(first), static_cast<size_t>(last - first), key, alloc);
+    }
+
+    template<class It>
+    void radixSort(It first, It last) {
+        goose::radixSort(first, last, _implementation::_identityKey{});
+    }
+}
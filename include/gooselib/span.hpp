@@ -0,0 +1,52 @@
+#pragma once
+
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include <cstddef>
+
+namespace goose {
+    // Non-owning view of a contiguous run of T. Iterators are plain pointers, so the contiguous
+    // fast paths in algorithm.hpp apply to it directly.
+    template<typename T>
+    struct span {
+        public:
+            using elementType = T;
+            using valueType = removeCV<T>;
+            using sizeType = size_t;
+            using differenceType = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+            using iterator = T*;
+            using reverseIterator = goose::reverseIterator<iterator>;
+        public:
+            constexpr span() noexcept = default;
+            constexpr span(T* data, sizeType size) noexcept : mData{data}, mSize{size} {}
+            constexpr span(T* first, T* last) noexcept : mData{first}, mSize{static_cast<sizeType>(last - first)} {}
+            template<size_t N>
+            constexpr span(T (&array)[N]) noexcept : mData{array}, mSize{N} {}
+            template<typename U, typename = enableIfT<std::is_convertible_v<U (*)[], T (*)[]>>>
+            constexpr span(const span<U>& other) noexcept : mData{other.data()}, mSize{other.size()} {}
+        public:
+            constexpr reference operator[](sizeType pos) const noexcept { return mData[pos]; }
+            constexpr reference front() const noexcept { return mData[0]; }
+            constexpr reference back() const noexcept { return mData[mSize - 1]; }
+            constexpr pointer data() const noexcept { return mData; }
+
+            constexpr sizeType size() const noexcept { return mSize; }
+            constexpr sizeType sizeBytes() const noexcept { return mSize * sizeof(T); }
+            constexpr bool empty() const noexcept { return mSize == 0; }
+
+            constexpr span first(sizeType count) const noexcept { return {mData, count}; }
+            constexpr span last(sizeType count) const noexcept { return {mData + mSize - count, count}; }
+            constexpr span subspan(sizeType offset, sizeType count) const noexcept { return {mData + offset, count}; }
+            constexpr span subspan(sizeType offset) const noexcept { return {mData + offset, mSize - offset}; }
+        public:
+            constexpr iterator begin() const noexcept { return mData; }
+            constexpr iterator end() const noexcept { return mData + mSize; }
+            constexpr reverseIterator rbegin() const noexcept { return end(); }
+            constexpr reverseIterator rend() const noexcept { return begin(); }
+        private:
+            T* mData{nullptr};
+            sizeType mSize{0};
+    };
+}
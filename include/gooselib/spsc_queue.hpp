@@ -0,0 +1,121 @@
+#pragma once
+
+#include "array.hpp"
+#include "memory.hpp"
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+namespace goose {
+    // Bounded wait-free queue between exactly one producer thread and one consumer thread.
+    // Slots live inline in a goose::array, so T has to be default constructible; push assigns
+    // into a slot and pop moves out of it. Capacity must be a power of two.
+    template<typename T, size_t Capacity>
+    struct spscQueue {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "spscQueue capacity must be a power of two");
+        static_assert(std::is_default_constructible_v<T>, "spscQueue stores its slots in a goose::array");
+        public:
+            using valueType = T;
+            using sizeType = size_t;
+        public:
+            spscQueue() = default;
+            spscQueue(const spscQueue&) = delete;
+            spscQueue& operator=(const spscQueue&) = delete;
+        public:
+            static constexpr sizeType capacity() noexcept { return Capacity; }
+
+            // Both are only a snapshot when the other side is running concurrently. The head is read
+            // first so it can never be ahead of the tail; the consumer may still move on between the
+            // loads, so the result is clamped to the capacity.
+            sizeType size() const noexcept {
+                size_t head = mHead.load(std::memory_order_acquire);
+                size_t tail = mTail.load(std::memory_order_acquire);
+                size_t count = tail - head;
+                return count < Capacity ? count : Capacity;
+            }
+            bool empty() const noexcept { return size() == 0; }
+        public:
+            // Producer side.
+            bool tryPush(const T& value) { return pushOne(value); }
+            bool tryPush(T&& value) { return pushOne(std::move(value)); }
+
+            // Pushes as many of the count items starting at first as fit and returns how many that
+            // was. The whole batch is published with a single release store.
+            template<typename It>
+            sizeType tryPushN(It first, sizeType count) {
+                size_t tail = mTail.load(std::memory_order_relaxed);
+                size_t free = Capacity - (tail - mCachedHead);
+                if (free < count) {
+                    mCachedHead = mHead.load(std::memory_order_acquire);
+                    free = Capacity - (tail - mCachedHead);
+                }
+                if (count > free) count = free;
+                if (count == 0) return 0;
+
+                // At most two contiguous runs: up to the end of the storage, then from its start.
+                size_t start = tail & mask;
+                size_t firstRun = Capacity - start < count ? Capacity - start : count;
+                T* slots = &mSlots[0];
+                for (size_t i = 0; i < firstRun; ++i, ++first) slots[start + i] = *first;
+                for (size_t i = firstRun; i < count; ++i, ++first) slots[i - firstRun] = *first;
+                mTail.store(tail + count, std::memory_order_release);
+                return count;
+            }
+
+            // Consumer side.
+            bool tryPop(T& out) {
+                size_t head = mHead.load(std::memory_order_relaxed);
+                if (head == mCachedTail) {
+                    mCachedTail = mTail.load(std::memory_order_acquire);
+                    if (head == mCachedTail) return false;
+                }
+                out = std::move(mSlots[head & mask]);
+                mHead.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Moves up to maxCount items to out and returns how many there were.
+            template<typename OutIt>
+            sizeType tryPopN(OutIt out, sizeType maxCount) {
+                size_t head = mHead.load(std::memory_order_relaxed);
+                size_t available = mCachedTail - head;
+                if (available < maxCount) {
+                    mCachedTail = mTail.load(std::memory_order_acquire);
+                    available = mCachedTail - head;
+                }
+                size_t count = available < maxCount ? available : maxCount;
+                if (count == 0) return 0;
+
+                size_t start = head & mask;
+                size_t firstRun = Capacity - start < count ? Capacity - start : count;
+                T* slots = &mSlots[0];
+                for (size_t i = 0; i < firstRun; ++i, ++out) *out = std::move(slots[start + i]);
+                for (size_t i = firstRun; i < count; ++i, ++out) *out = std::move(slots[i - firstRun]);
+                mHead.store(head + count, std::memory_order_release);
+                return count;
+            }
+        private:
+            static constexpr size_t mask = Capacity - 1;
+
+            template<typename U>
+            bool pushOne(U&& value) {
+                size_t tail = mTail.load(std::memory_order_relaxed);
+                if (tail - mCachedHead == Capacity) {
+                    mCachedHead = mHead.load(std::memory_order_acquire);
+                    if (tail - mCachedHead == Capacity) return false;
+                }
+                mSlots[tail & mask] = std::forward<U>(value);
+                mTail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+        private:
+            // Indices only ever grow and are reduced modulo Capacity on access. Each side keeps a
+            // private copy of the other's index and reloads it only when it looks full or empty,
+            // so the shared lines bounce between cores once per batch rather than per item.
+            alignas(cacheLineSize) std::atomic<size_t> mHead{0};
+            size_t mCachedTail{0};
+            alignas(cacheLineSize) std::atomic<size_t> mTail{0};
+            size_t mCachedHead{0};
+            alignas(cacheLineSize) goose::array<T, Capacity> mSlots{};
+    };
+}
@@ -0,0 +1,408 @@
+#pragma once
+
+#include "memory.hpp"
+#include "string_view.hpp"
+#include "utility.hpp"
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace goose {
+    // Null-terminated char string with the small-string optimization: up to three words minus
+    // one byte (23 chars on 64-bit targets) live inside the object, so short tokens never touch
+    // the allocator. The object is those three words; the last byte holds the spare inline room,
+    // which is zero, and so doubles as the terminator, when the inline buffer is full. A heap
+    // string marks that byte with its top bit instead.
+    //
+    // Move construction steals the heap buffer or copies the inline bytes and never allocates;
+    // move assignment does the same unless the allocators are unequal. Searches go through
+    // stringView.
+    template<typename Alloc = allocator<char>>
+    struct basicString {
+        private:
+            using myAllocTraits = allocatorTraits<Alloc>;
+            static constexpr size_t growthFactor = 2;
+
+            struct heapRep {
+                char* ptr;
+                size_t size;
+                size_t capWord;
+            };
+
+            static constexpr size_t inlineCapacity = sizeof(heapRep) - 1;
+            static constexpr unsigned char heapMarker = 0x80;
+            static constexpr bool littleEndian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+            static constexpr size_t markerShift = 8 * (sizeof(size_t) - 1);
+        public:
+            using valueType = char;
+            using allocatorType = Alloc;
+            using sizeType = size_t;
+            using differenceType = std::ptrdiff_t;
+            using reference = char&;
+            using constReference = const char&;
+            using pointer = char*;
+            using constPointer = const char*;
+            using iterator = char*;
+            using constIterator = const char*;
+            using reverseIterator = goose::reverseIterator<iterator>;
+            using constReverseIterator = goose::reverseIterator<constIterator>;
+
+            static constexpr sizeType npos = stringView::npos;
+        public:
+            basicString() noexcept(std::is_nothrow_default_constructible_v<Alloc>) { setInlineSize(0); }
+            explicit basicString(const Alloc& alloc) noexcept : mAlloc{alloc} { setInlineSize(0); }
+
+            basicString(const char* str, const Alloc& alloc = Alloc()) : basicString(stringView(str), alloc) {}
+            basicString(const char* str, sizeType count, const Alloc& alloc = Alloc()) : basicString(stringView(str, count), alloc) {}
+
+            explicit basicString(stringView view, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
+                char* dst = initStorage(view.size());
+                if (!view.empty()) std::memcpy(dst, view.data(), view.size());
+            }
+
+            basicString(sizeType count, char c, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
+                char* dst = initStorage(count);
+                std::memset(dst, c, count);
+            }
+
+            basicString(const basicString& other) : basicString(other.view(), other.mAlloc) {}
+
+            basicString(basicString&& other) noexcept : mAlloc{std::move(other.mAlloc)} {
+                takeFrom(other);
+            }
+
+            ~basicString() { releaseHeap(); }
+
+            basicString& operator=(const basicString& other) {
+                if (this != &other) assign(other.view());
+                return *this;
+            }
+
+            basicString& operator=(basicString&& other) noexcept(myAllocTraits::isAlwaysEqual::value) {
+                if (this == &other) return *this;
+                if constexpr (myAllocTraits::isAlwaysEqual::value) {
+                    releaseHeap();
+                    takeFrom(other);
+                } else {
+                    if (mAlloc == other.mAlloc) {
+                        releaseHeap();
+                        takeFrom(other);
+                    } else {
+                        assign(other.view());
+                        other.clear();
+                    }
+                }
+                return *this;
+            }
+
+            basicString& operator=(stringView view) { return assign(view); }
+            basicString& operator=(const char* str) { return assign(stringView(str)); }
+
+            operator stringView() const noexcept { return view(); }
+        public:
+            reference operator[](sizeType pos) noexcept { return data()[pos]; }
+            constReference operator[](sizeType pos) const noexcept { return data()[pos]; }
+
+            reference front() noexcept { return data()[0]; }
+            constReference front() const noexcept { return data()[0]; }
+            reference back() noexcept { return data()[size() - 1]; }
+            constReference back() const noexcept { return data()[size() - 1]; }
+
+            char* data() noexcept { return isInline() ? mRep.bytes : mRep.heap.ptr; }
+            const char* data() const noexcept { return isInline() ? mRep.bytes : mRep.heap.ptr; }
+            const char* cStr() const noexcept { return data(); }
+            stringView view() const noexcept { return {data(), size()}; }
+        public:
+            iterator begin() noexcept { return data(); }
+            constIterator begin() const noexcept { return cbegin(); }
+            constIterator cbegin() const noexcept { return data(); }
+            iterator end() noexcept { return data() + size(); }
+            constIterator end() const noexcept { return cend(); }
+            constIterator cend() const noexcept { return data() + size(); }
+            reverseIterator rbegin() noexcept { return end(); }
+            reverseIterator rend() noexcept { return begin(); }
+            constReverseIterator rbegin() const noexcept { return crbegin(); }
+            constReverseIterator rend() const noexcept { return crend(); }
+            constReverseIterator crbegin() const noexcept { return cend(); }
+            constReverseIterator crend() const noexcept { return cbegin(); }
+        public:
+            sizeType size() const noexcept { return isInline() ? inlineCapacity - markerByte() : mRep.heap.size; }
+            sizeType length() const noexcept { return size(); }
+            sizeType capacity() const noexcept { return isInline() ? inlineCapacity : heapCapacity(); }
+            bool empty() const noexcept { return size() == 0; }
+            bool isInline() const noexcept { return (markerByte() & heapMarker) == 0; }
+            allocatorType getAllocator() const noexcept { return mAlloc; }
+        public:
+            void reserve(sizeType newCap) {
+                if (newCap > capacity()) reallocate(newCap);
+            }
+
+            // Moves back into the object when the chars fit, otherwise trims the heap buffer.
+            void shrinkToFit() {
+                if (isInline() || size() == capacity()) return;
+                reallocate(size());
+            }
+
+            void clear() noexcept { setSize(0); }
+
+            basicString& assign(stringView view) {
+                sizeType count = view.size();
+                if (count <= capacity()) {
+                    // view may point into this string.
+                    if (count) std::memmove(data(), view.data(), count);
+                    setSize(count);
+                } else {
+                    basicString copy(view, mAlloc);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            basicString& append(stringView view) {
+                sizeType oldSize = size();
+                sizeType count = view.size();
+                if (count <= capacity() - oldSize) {
+                    if (count) std::memcpy(data() + oldSize, view.data(), count);
+                    setSize(oldSize + count);
+                } else {
+                    // Copy from view before the old buffer, which view may point into, goes away.
+                    sizeType newCap = grownCapacity(oldSize + count);
+                    char* newChars = myAllocTraits::allocate(mAlloc, newCap + 1);
+                    std::memcpy(newChars, data(), oldSize);
+                    std::memcpy(newChars + oldSize, view.data(), count);
+                    releaseHeap();
+                    setHeap(newChars, oldSize + count, newCap);
+                }
+                return *this;
+            }
+
+            basicString& append(sizeType count, char c) {
+                sizeType oldSize = size();
+                if (count > capacity() - oldSize) reallocate(grownCapacity(oldSize + count));
+                std::memset(data() + oldSize, c, count);
+                setSize(oldSize + count);
+                return *this;
+            }
+
+            basicString& operator+=(stringView view) { return append(view); }
+            basicString& operator+=(const char* str) { return append(stringView(str)); }
+            basicString& operator+=(char c) {
+                pushBack(c);
+                return *this;
+            }
+
+            void pushBack(char c) {
+                sizeType oldSize = size();
+                if (oldSize == capacity()) reallocate(grownCapacity(oldSize + 1));
+                data()[oldSize] = c;
+                setSize(oldSize + 1);
+            }
+
+            void popBack() noexcept { setSize(size() - 1); }
+
+            // New chars take c.
+            void resize(sizeType count, char c = '\0') {
+                sizeType oldSize = size();
+                if (count > oldSize) append(count - oldSize, c);
+                else setSize(count);
+            }
+
+            basicString& insert(sizeType pos, stringView view) {
+                const char* chars = data();
+                if (view.data() >= chars && view.data() < chars + size()) {
+                    basicString copy(view, mAlloc);
+                    return insert(pos, copy.view());
+                }
+                sizeType oldSize = size();
+                sizeType count = view.size();
+                if (count > capacity() - oldSize) reallocate(grownCapacity(oldSize + count));
+                char* dst = data();
+                std::memmove(dst + pos + count, dst + pos, oldSize - pos);
+                if (count) std::memcpy(dst + pos, view.data(), count);
+                setSize(oldSize + count);
+                return *this;
+            }
+
+            // Removes up to count chars starting at pos.
+            basicString& erase(sizeType pos, sizeType count = npos) {
+                sizeType oldSize = size();
+                if (count > oldSize - pos) count = oldSize - pos;
+                char* chars = data();
+                std::memmove(chars + pos, chars + pos + count, oldSize - pos - count);
+                setSize(oldSize - count);
+                return *this;
+            }
+
+            basicString substr(sizeType pos, sizeType count = npos) const { return basicString(view().substr(pos, count), mAlloc); }
+
+            void swap(basicString& other) noexcept {
+                goose::swap(mRep, other.mRep);
+                goose::swap(mAlloc, other.mAlloc);
+            }
+        public:
+            sizeType find(char c, sizeType pos = 0) const noexcept { return view().find(c, pos); }
+            sizeType find(stringView needle, sizeType pos = 0) const noexcept { return view().find(needle, pos); }
+            sizeType rfind(char c, sizeType pos = npos) const noexcept { return view().rfind(c, pos); }
+            sizeType findFirstOf(stringView set, sizeType pos = 0) const noexcept { return view().findFirstOf(set, pos); }
+            sizeType findFirstNotOf(stringView set, sizeType pos = 0) const noexcept { return view().findFirstNotOf(set, pos); }
+            bool contains(char c) const noexcept { return view().contains(c); }
+            bool contains(stringView needle) const noexcept { return view().contains(needle); }
+            bool startsWith(stringView prefix) const noexcept { return view().startsWith(prefix); }
+            bool endsWith(stringView suffix) const noexcept { return view().endsWith(suffix); }
+            int compare(stringView other) const noexcept { return view().compare(other); }
+        private:
+            unsigned char markerByte() const noexcept { return static_cast<unsigned char>(mRep.bytes[inlineCapacity]); }
+
+            // The marker byte is the most significant byte of capWord on little-endian targets
+            // and the least significant one on big-endian ones, so the capacity gets the rest.
+            sizeType heapCapacity() const noexcept {
+                return littleEndian ? mRep.heap.capWord & (~size_t{0} >> 8) : mRep.heap.capWord >> 8;
+            }
+
+            static sizeType encodeCapacity(sizeType cap) noexcept {
+                return littleEndian ? cap | size_t{heapMarker} << markerShift : cap << 8 | heapMarker;
+            }
+
+            sizeType grownCapacity(sizeType needed) const noexcept {
+                sizeType grown = capacity() * growthFactor;
+                return grown > needed ? grown : needed;
+            }
+
+            // Terminator first: with a full inline buffer the marker byte is the terminator.
+            void setInlineSize(sizeType count) noexcept {
+                mRep.bytes[count] = '\0';
+                mRep.bytes[inlineCapacity] = static_cast<char>(inlineCapacity - count);
+            }
+
+            void setHeap(char* chars, sizeType count, sizeType cap) noexcept {
+                chars[count] = '\0';
+                mRep.heap.ptr = chars;
+                mRep.heap.size = count;
+                mRep.heap.capWord = encodeCapacity(cap);
+            }
+
+            void setSize(sizeType count) noexcept {
+                if (isInline()) {
+                    setInlineSize(count);
+                } else {
+                    mRep.heap.size = count;
+                    mRep.heap.ptr[count] = '\0';
+                }
+            }
+
+            // Storage for count chars (plus the terminator) in a freshly constructed string.
+            char* initStorage(sizeType count) {
+                if (count <= inlineCapacity) {
+                    setInlineSize(count);
+                    return mRep.bytes;
+                }
+                char* chars = myAllocTraits::allocate(mAlloc, count + 1);
+                setHeap(chars, count, count);
+                return chars;
+            }
+
+            void reallocate(sizeType newCap) {
+                sizeType count = size();
+                if (newCap <= inlineCapacity) {
+                    if (isInline()) return;
+                    char* heapChars = mRep.heap.ptr;
+                    sizeType heapCap = heapCapacity();
+                    std::memcpy(mRep.bytes, heapChars, count);
+                    setInlineSize(count);
+                    myAllocTraits::deallocate(mAlloc, heapChars, heapCap + 1);
+                    return;
+                }
+                char* newChars = myAllocTraits::allocate(mAlloc, newCap + 1);
+                std::memcpy(newChars, data(), count);
+                releaseHeap();
+                setHeap(newChars, count, newCap);
+            }
+
+            void releaseHeap() noexcept {
+                if (isInline()) return;
+                myAllocTraits::deallocate(mAlloc, mRep.heap.ptr, heapCapacity() + 1);
+                setInlineSize(0);
+            }
+
+            void takeFrom(basicString& other) noexcept {
+                mRep = other.mRep;
+                other.setInlineSize(0);
+            }
+        private:
+            union rep {
+                heapRep heap;
+                char bytes[sizeof(heapRep)];
+            };
+
+            rep mRep;
+            // Stateless allocators take no room, keeping the string at three words.
+            [[no_unique_address]] Alloc mAlloc;
+    };
+
+    using string = basicString<>;
+
+    template<typename Alloc>
+    void swap(basicString<Alloc>& lhs, basicString<Alloc>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    template<typename Alloc>
+    basicString<Alloc> operator+(basicString<Alloc> lhs, stringView rhs) {
+        lhs.append(rhs);
+        return lhs;
+    }
+
+    template<typename Alloc>
+    basicString<Alloc> operator+(basicString<Alloc> lhs, char rhs) {
+        lhs.pushBack(rhs);
+        return lhs;
+    }
+
+    // Comparisons against strings, views and literals. Templates so that a literal converts to
+    // stringView rather than competing with the basicString constructor.
+    template<typename Alloc>
+    bool operator==(const basicString<Alloc>& lhs, const basicString<Alloc>& rhs) noexcept { return lhs.view() == rhs.view(); }
+    template<typename Alloc>
+    bool operator==(const basicString<Alloc>& lhs, stringView rhs) noexcept { return lhs.view() == rhs; }
+    template<typename Alloc>
+    bool operator==(stringView lhs, const basicString<Alloc>& rhs) noexcept { return lhs == rhs.view(); }
+    template<typename Alloc>
+    bool operator!=(const basicString<Alloc>& lhs, const basicString<Alloc>& rhs) noexcept { return lhs.view() != rhs.view(); }
+    template<typename Alloc>
+    bool operator!=(const basicString<Alloc>& lhs, stringView rhs) noexcept { return lhs.view() != rhs; }
+    template<typename Alloc>
+    bool operator!=(stringView lhs, const basicString<Alloc>& rhs) noexcept { return lhs != rhs.view(); }
+    template<typename Alloc>
+    bool operator<(const basicString<Alloc>& lhs, const basicString<Alloc>& rhs) noexcept { return lhs.view() < rhs.view(); }
+    template<typename Alloc>
+    bool operator<(const basicString<Alloc>& lhs, stringView rhs) noexcept { return lhs.view() < rhs; }
+    template<typename Alloc>
+    bool operator<(stringView lhs, const basicString<Alloc>& rhs) noexcept { return lhs < rhs.view(); }
+    template<typename Alloc>
+    bool operator<=(const basicString<Alloc>& lhs, const basicString<Alloc>& rhs) noexcept { return lhs.view() <= rhs.view(); }
+    template<typename Alloc>
+    bool operator<=(const basicString<Alloc>& lhs, stringView rhs) noexcept { return lhs.view() <= rhs; }
+    template<typename Alloc>
+    bool operator<=(stringView lhs, const basicString<Alloc>& rhs) noexcept { return lhs <= rhs.view(); }
+    template<typename Alloc>
+    bool operator>(const basicString<Alloc>& lhs, const basicString<Alloc>& rhs) noexcept { return lhs.view() > rhs.view(); }
+    template<typename Alloc>
+    bool operator>(const basicString<Alloc>& lhs, stringView rhs) noexcept { return lhs.view() > rhs; }
+    template<typename Alloc>
+    bool operator>(stringView lhs, const basicString<Alloc>& rhs) noexcept { return lhs > rhs.view(); }
+    template<typename Alloc>
+    bool operator>=(const basicString<Alloc>& lhs, const basicString<Alloc>& rhs) noexcept { return lhs.view() >= rhs.view(); }
+    template<typename Alloc>
+    bool operator>=(const basicString<Alloc>& lhs, stringView rhs) noexcept { return lhs.view() >= rhs; }
+    template<typename Alloc>
+    bool operator>=(stringView lhs, const basicString<Alloc>& rhs) noexcept { return lhs >= rhs.view(); }
+}
+
+namespace std {
+    template<typename Alloc>
+    struct hash<goose::basicString<Alloc>> {
+        size_t operator()(const goose::basicString<Alloc>& str) const noexcept {
+            return hash<goose::stringView>{}(str.view());
+        }
+    };
+}
@@ -0,0 +1,338 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace goose {
+    namespace _implementation {
+        inline constexpr size_t _npos = static_cast<size_t>(-1);
+
+        // Character sets up to this size are matched with one vector compare per member; larger
+        // ones go through a 256-entry table a byte at a time.
+        inline constexpr size_t _vectorSetLimit = 8;
+
+        namespace simd {
+            // Substring search that only runs memcmp where both the needle's first and last
+            // characters line up, checking a register's worth of start positions per step.
+            // Needs needleSize >= 2 and pos + needleSize <= size.
+            inline size_t findSubstring(const char* haystack, size_t size, const char* needle, size_t needleSize,
+                                        size_t pos) noexcept {
+                size_t lastStart = size - needleSize;
+#if defined(__SSE2__)
+                reg firstChar = broadcast(needle[0]);
+                reg lastChar = broadcast(needle[needleSize - 1]);
+                auto scan = [&](size_t at) {
+                    uint32_t mask = byteMask(bitAnd(cmpeq<1>(load(haystack + at), firstChar),
+                                                    cmpeq<1>(load(haystack + at + needleSize - 1), lastChar)));
+                    for (; mask; mask &= mask - 1) {
+                        size_t start = at + __builtin_ctz(mask);
+                        if (std::memcmp(haystack + start + 1, needle + 1, needleSize - 2) == 0) return start;
+                    }
+                    return _npos;
+                };
+                if (lastStart - pos + 1 >= width) {
+                    for (; lastStart - pos + 1 >= width; pos += width) {
+                        size_t hit = scan(pos);
+                        if (hit != _npos) return hit;
+                    }
+                    // The final block overlaps starts already rejected, which reject again.
+                    return pos <= lastStart ? scan(lastStart + 1 - width) : _npos;
+                }
+#endif
+                for (; pos <= lastStart; ++pos) {
+                    if (haystack[pos] == needle[0] && haystack[pos + needleSize - 1] == needle[needleSize - 1]
+                        && std::memcmp(haystack + pos + 1, needle + 1, needleSize - 2) == 0) {
+                        return pos;
+                    }
+                }
+                return _npos;
+            }
+
+            // First position at or after pos whose character is (Matching) or is not (!Matching)
+            // in set. Needs pos < size and a non-empty set.
+            template<bool Matching>
+            size_t findFirstOf(const char* data, size_t size, const char* set, size_t setSize, size_t pos) noexcept {
+                if (setSize <= _vectorSetLimit) {
+#if defined(__SSE2__)
+                    if (size - pos >= width) {
+                        reg members[_vectorSetLimit];
+                        for (size_t i = 0; i < setSize; ++i) members[i] = broadcast(set[i]);
+                        auto scan = [&](size_t at) {
+                            reg block = load(data + at);
+                            reg hits = cmpeq<1>(block, members[0]);
+                            for (size_t i = 1; i < setSize; ++i) hits = bitOr(hits, cmpeq<1>(block, members[i]));
+                            uint32_t mask = byteMask(hits);
+                            if constexpr (!Matching) mask = ~mask & static_cast<uint32_t>((uint64_t{1} << width) - 1);
+                            return mask ? at + __builtin_ctz(mask) : _npos;
+                        };
+                        for (; size - pos >= width; pos += width) {
+                            size_t hit = scan(pos);
+                            if (hit != _npos) return hit;
+                        }
+                        return pos < size ? scan(size - width) : _npos;
+                    }
+#endif
+                    for (; pos < size; ++pos) {
+                        bool member = false;
+                        for (size_t i = 0; i < setSize; ++i) member |= data[pos] == set[i];
+                        if (member == Matching) return pos;
+                    }
+                    return _npos;
+                }
+                bool table[256] = {};
+                for (size_t i = 0; i < setSize; ++i) table[static_cast<unsigned char>(set[i])] = true;
+                for (; pos < size; ++pos) {
+                    if (table[static_cast<unsigned char>(data[pos])] == Matching) return pos;
+                }
+                return _npos;
+            }
+        }
+
+        template<bool AnyOf>
+        struct _splitRange;
+    }
+
+    // Non-owning view of a run of chars. Searches take vector paths at run time and plain loops
+    // during constant evaluation. Converts from std::string_view and std::string, and explicitly
+    // back to std::string_view.
+    struct stringView {
+        public:
+            using valueType = char;
+            using sizeType = size_t;
+            using differenceType = std::ptrdiff_t;
+            using pointer = const char*;
+            using reference = const char&;
+            using iterator = const char*;
+            using reverseIterator = goose::reverseIterator<iterator>;
+
+            static constexpr sizeType npos = _implementation::_npos;
+        public:
+            constexpr stringView() noexcept = default;
+            constexpr stringView(const char* str) noexcept : mData{str}, mSize{__builtin_strlen(str)} {}
+            constexpr stringView(const char* data, sizeType size) noexcept : mData{data}, mSize{size} {}
+
+            template<typename S, typename = enableIfT<std::is_convertible_v<const S&, std::string_view>
+                                                      && !std::is_convertible_v<const S&, const char*>>>
+            constexpr stringView(const S& str) noexcept {
+                std::string_view view = str;
+                mData = view.data();
+                mSize = view.size();
+            }
+
+            constexpr explicit operator std::string_view() const noexcept { return {mData, mSize}; }
+        public:
+            constexpr reference operator[](sizeType pos) const noexcept { return mData[pos]; }
+            constexpr reference front() const noexcept { return mData[0]; }
+            constexpr reference back() const noexcept { return mData[mSize - 1]; }
+            constexpr pointer data() const noexcept { return mData; }
+
+            constexpr sizeType size() const noexcept { return mSize; }
+            constexpr sizeType length() const noexcept { return mSize; }
+            constexpr bool empty() const noexcept { return mSize == 0; }
+
+            constexpr iterator begin() const noexcept { return mData; }
+            constexpr iterator end() const noexcept { return mData + mSize; }
+            reverseIterator rbegin() const noexcept { return end(); }
+            reverseIterator rend() const noexcept { return begin(); }
+        public:
+            constexpr void removePrefix(sizeType count) noexcept {
+                mData += count;
+                mSize -= count;
+            }
+            constexpr void removeSuffix(sizeType count) noexcept { mSize -= count; }
+
+            // Clamps pos and count to the view instead of throwing.
+            constexpr stringView substr(sizeType pos, sizeType count = npos) const noexcept {
+                if (pos > mSize) pos = mSize;
+                return {mData + pos, count < mSize - pos ? count : mSize - pos};
+            }
+
+            constexpr int compare(stringView other) const noexcept {
+                sizeType common = mSize < other.mSize ? mSize : other.mSize;
+                int result = common ? __builtin_memcmp(mData, other.mData, common) : 0;
+                if (result != 0) return result;
+                return mSize == other.mSize ? 0 : (mSize < other.mSize ? -1 : 1);
+            }
+
+            constexpr bool startsWith(stringView prefix) const noexcept {
+                return mSize >= prefix.mSize && substr(0, prefix.mSize).compare(prefix) == 0;
+            }
+            constexpr bool startsWith(char c) const noexcept { return mSize && mData[0] == c; }
+            constexpr bool endsWith(stringView suffix) const noexcept {
+                return mSize >= suffix.mSize && substr(mSize - suffix.mSize).compare(suffix) == 0;
+            }
+            constexpr bool endsWith(char c) const noexcept { return mSize && mData[mSize - 1] == c; }
+        public:
+            constexpr sizeType find(char c, sizeType pos = 0) const noexcept {
+                if (pos >= mSize) return npos;
+                if (!_implementation::_isConstantEvaluated()) {
+                    // glibc's memchr is already vectorized.
+                    const void* hit = std::memchr(mData + pos, c, mSize - pos);
+                    return hit ? static_cast<sizeType>(static_cast<const char*>(hit) - mData) : npos;
+                }
+                for (; pos < mSize; ++pos) {
+                    if (mData[pos] == c) return pos;
+                }
+                return npos;
+            }
+
+            constexpr sizeType find(stringView needle, sizeType pos = 0) const noexcept {
+                if (pos > mSize || needle.mSize > mSize - pos) return npos;
+                if (needle.mSize == 0) return pos;
+                if (needle.mSize == 1) return find(needle[0], pos);
+                if (!_implementation::_isConstantEvaluated()) {
+                    return _implementation::simd::findSubstring(mData, mSize, needle.mData, needle.mSize, pos);
+                }
+                for (; pos + needle.mSize <= mSize; ++pos) {
+                    if (substr(pos, needle.mSize).compare(needle) == 0) return pos;
+                }
+                return npos;
+            }
+
+            constexpr sizeType rfind(char c, sizeType pos = npos) const noexcept {
+                for (sizeType i = pos < mSize ? pos + 1 : mSize; i > 0; --i) {
+                    if (mData[i - 1] == c) return i - 1;
+                }
+                return npos;
+            }
+
+            constexpr bool contains(char c) const noexcept { return find(c) != npos; }
+            constexpr bool contains(stringView needle) const noexcept { return find(needle) != npos; }
+
+            // First position at or after pos holding any char of set.
+            constexpr sizeType findFirstOf(stringView set, sizeType pos = 0) const noexcept {
+                return findFirstOfImpl<true>(set, pos);
+            }
+
+            // First position at or after pos holding a char not in set.
+            constexpr sizeType findFirstNotOf(stringView set, sizeType pos = 0) const noexcept {
+                return findFirstOfImpl<false>(set, pos);
+            }
+        public:
+            // Fields between occurrences of delimiter, empty ones included: "a,,b" splits into "a",
+            // "", "b", and an empty view into one empty field.
+            constexpr _implementation::_splitRange<false> split(char delimiter) const noexcept;
+            // Same, with any char of delimiters ending a field.
+            constexpr _implementation::_splitRange<true> splitAny(stringView delimiters) const noexcept;
+        public:
+            friend constexpr bool operator==(stringView lhs, stringView rhs) noexcept {
+                return lhs.mSize == rhs.mSize && lhs.compare(rhs) == 0;
+            }
+            friend constexpr bool operator!=(stringView lhs, stringView rhs) noexcept { return !(lhs == rhs); }
+            friend constexpr bool operator<(stringView lhs, stringView rhs) noexcept { return lhs.compare(rhs) < 0; }
+            friend constexpr bool operator<=(stringView lhs, stringView rhs) noexcept { return lhs.compare(rhs) <= 0; }
+            friend constexpr bool operator>(stringView lhs, stringView rhs) noexcept { return lhs.compare(rhs) > 0; }
+            friend constexpr bool operator>=(stringView lhs, stringView rhs) noexcept { return lhs.compare(rhs) >= 0; }
+        private:
+            template<bool Matching>
+            constexpr sizeType findFirstOfImpl(stringView set, sizeType pos) const noexcept {
+                if (pos >= mSize) return npos;
+                if (set.mSize == 0) return Matching ? npos : pos;
+                if (!_implementation::_isConstantEvaluated()) {
+                    return _implementation::simd::findFirstOf<Matching>(mData, mSize, set.mData, set.mSize, pos);
+                }
+                for (; pos < mSize; ++pos) {
+                    if (set.contains(mData[pos]) == Matching) return pos;
+                }
+                return npos;
+            }
+        private:
+            const char* mData{nullptr};
+            sizeType mSize{0};
+    };
+
+    namespace _implementation {
+        // Range over the fields of a stringView, produced by stringView::split and splitAny.
+        template<bool AnyOf>
+        struct _splitRange {
+            private:
+                using delimiterType = std::conditional_t<AnyOf, stringView, char>;
+            public:
+                struct iterator {
+                    public:
+                        using valueType = stringView;
+                        using differenceType = std::ptrdiff_t;
+                        using reference = const stringView&;
+                        using pointer = const stringView*;
+                        using iteratorCategory = forwardIteratorTag;
+                    public:
+                        constexpr iterator() noexcept = default;
+                        constexpr iterator(stringView source, delimiterType delimiter) noexcept
+                            : mSource{source}, mDelimiter{delimiter}, mNext{0}, mDone{false} {
+                            advance();
+                        }
+
+                        constexpr reference operator*() const noexcept { return mField; }
+                        constexpr pointer operator->() const noexcept { return &mField; }
+
+                        constexpr iterator& operator++() noexcept {
+                            advance();
+                            return *this;
+                        }
+
+                        constexpr iterator operator++(int) noexcept {
+                            iterator copy = *this;
+                            advance();
+                            return copy;
+                        }
+
+                        friend constexpr bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+                            return lhs.mDone == rhs.mDone && (lhs.mDone || lhs.mField.data() == rhs.mField.data());
+                        }
+                        friend constexpr bool operator!=(const iterator& lhs, const iterator& rhs) noexcept { return !(lhs == rhs); }
+                    private:
+                        // mNext is npos once the last field has been handed out.
+                        constexpr void advance() noexcept {
+                            if (mNext == _npos) {
+                                mDone = true;
+                                return;
+                            }
+                            size_t end = findEnd();
+                            mField = mSource.substr(mNext, end == _npos ? _npos : end - mNext);
+                            mNext = end == _npos ? _npos : end + 1;
+                        }
+                        constexpr size_t findEnd() const noexcept {
+                            if constexpr (AnyOf) return mSource.findFirstOf(mDelimiter, mNext);
+                            else return mSource.find(mDelimiter, mNext);
+                        }
+                    private:
+                        stringView mSource;
+                        delimiterType mDelimiter{};
+                        stringView mField;
+                        size_t mNext{_npos};
+                        bool mDone{true};
+                };
+            public:
+                constexpr _splitRange(stringView source, delimiterType delimiter) noexcept
+                    : mSource{source}, mDelimiter{delimiter} {}
+
+                constexpr iterator begin() const noexcept { return {mSource, mDelimiter}; }
+                constexpr iterator end() const noexcept { return {}; }
+            private:
+                stringView mSource;
+                delimiterType mDelimiter;
+        };
+    }
+
+    constexpr _implementation::_splitRange<false> stringView::split(char delimiter) const noexcept {
+        return {*this, delimiter};
+    }
+
+    constexpr _implementation::_splitRange<true> stringView::splitAny(stringView delimiters) const noexcept {
+        return {*this, delimiters};
+    }
+}
+
+namespace std {
+    template<>
+    struct hash<goose::stringView> {
+        size_t operator()(goose::stringView view) const noexcept {
+            return hash<string_view>{}(string_view(view));
+        }
+    };
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "vector.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace goose {
+    // Work-stealing pool. Every worker owns a deque: it pushes and pops its own tasks at the
+    // back and idle workers steal from the front, where the largest pieces of a recursive split
+    // end up. Threads that are not workers push round-robin and help out while they wait.
+    struct threadPool {
+        public:
+            using task = std::function<void()>;
+        private:
+            struct worker {
+                std::mutex lock;
+                std::deque<task> tasks;
+            };
+        public:
+            explicit threadPool(size_t threadCount = defaultThreadCount()) : mWorkers(threadCount ? threadCount : 1) {
+                mThreads.reserve(mWorkers.size());
+                for (size_t i = 0; i < mWorkers.size(); ++i) {
+                    mThreads.emplaceBack([this, i] { workerLoop(i); });
+                }
+            }
+
+            threadPool(const threadPool&) = delete;
+            threadPool& operator=(const threadPool&) = delete;
+
+            ~threadPool() {
+                {
+                    std::lock_guard<std::mutex> guard(mSleepLock);
+                    mStopping = true;
+                }
+                mWake.notify_all();
+                for (auto& thread : mThreads) thread.join();
+            }
+
+            static size_t defaultThreadCount() noexcept {
+                size_t count = std::thread::hardware_concurrency();
+                return count ? count : 1;
+            }
+
+            static threadPool& global() {
+                static threadPool pool;
+                return pool;
+            }
+        public:
+            size_t size() const noexcept { return mWorkers.size(); }
+
+            void submit(task t) {
+                size_t index = currentPool() == this ? currentIndex()
+                                                     : mNextQueue.fetch_add(1, std::memory_order_relaxed) % mWorkers.size();
+                {
+                    std::lock_guard<std::mutex> guard(mWorkers[index].lock);
+                    mWorkers[index].tasks.push_back(std::move(t));
+                }
+                mQueued.fetch_add(1, std::memory_order_release);
+                wakeOne();
+            }
+
+            // Runs one queued task on the calling thread, preferring its own deque when it is a
+            // worker. Returns false if there was nothing to run.
+            bool runPendingTask() {
+                size_t home = currentPool() == this ? currentIndex() : 0;
+                task t;
+                if (!popTask(home, t)) return false;
+                t();
+                return true;
+            }
+        private:
+            static threadPool*& currentPool() noexcept {
+                static thread_local threadPool* pool = nullptr;
+                return pool;
+            }
+
+            static size_t& currentIndex() noexcept {
+                static thread_local size_t index = 0;
+                return index;
+            }
+
+            bool popTask(size_t home, task& out) {
+                if (mQueued.load(std::memory_order_acquire) == 0) return false;
+                {
+                    worker& own = mWorkers[home];
+                    std::lock_guard<std::mutex> guard(own.lock);
+                    if (!own.tasks.empty()) {
+                        out = std::move(own.tasks.back());
+                        own.tasks.pop_back();
+                        mQueued.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+                for (size_t offset = 1; offset < mWorkers.size(); ++offset) {
+                    worker& victim = mWorkers[(home + offset) % mWorkers.size()];
+                    std::unique_lock<std::mutex> guard(victim.lock, std::try_to_lock);
+                    if (guard.owns_lock() && !victim.tasks.empty()) {
+                        out = std::move(victim.tasks.front());
+                        victim.tasks.pop_front();
+                        mQueued.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Workers register as sleepers before their last look at mQueued and submitters check
+            // for sleepers after publishing; the fences on both sides make sure at least one of them
+            // notices, so the lock and the notify are skipped while every worker is busy.
+            void wakeOne() {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (mSleepers.load(std::memory_order_relaxed) == 0) return;
+                {
+                    std::lock_guard<std::mutex> guard(mSleepLock);
+                }
+                mWake.notify_one();
+            }
+
+            void workerLoop(size_t index) {
+                currentPool() = this;
+                currentIndex() = index;
+                task t;
+                while (true) {
+                    if (popTask(index, t)) {
+                        t();
+                        t = nullptr;
+                        continue;
+                    }
+                    // A failed try_lock while stealing can miss queued work, so keep polling rather
+                    // than sleeping while anything is still queued.
+                    if (mQueued.load(std::memory_order_acquire) > 0) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    mSleepers.fetch_add(1, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    bool stopping;
+                    {
+                        std::unique_lock<std::mutex> guard(mSleepLock);
+                        mWake.wait(guard, [this] { return mStopping || mQueued.load(std::memory_order_acquire) > 0; });
+                        stopping = mStopping;
+                    }
+                    mSleepers.fetch_sub(1, std::memory_order_relaxed);
+                    if (stopping) return;
+                }
+            }
+        private:
+            goose::vector<worker> mWorkers;
+            goose::vector<std::thread> mThreads;
+            std::atomic<size_t> mQueued{0};
+            std::atomic<size_t> mNextQueue{0};
+            std::atomic<size_t> mSleepers{0};
+            std::mutex mSleepLock;
+            std::condition_variable mWake;
+            bool mStopping{false};
+    };
+
+    // Fork-join scope over a pool. wait() helps run queued tasks until every task started through
+    // this group has finished, then rethrows the first exception any of them threw.
+    struct taskGroup {
+        public:
+            explicit taskGroup(threadPool& pool) noexcept : mPool{pool} {}
+
+            taskGroup(const taskGroup&) = delete;
+            taskGroup& operator=(const taskGroup&) = delete;
+
+            ~taskGroup() {
+                while (mPending.load(std::memory_order_acquire) != 0) {
+                    if (!mPool.runPendingTask()) std::this_thread::yield();
+                }
+            }
+        public:
+            template<typename F>
+            void run(F&& f) {
+                mPending.fetch_add(1, std::memory_order_relaxed);
+                mPool.submit([this, f = std::forward<F>(f)]() mutable {
+                    try {
+                        f();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> guard(mErrorLock);
+                        if (!mError) mError = std::current_exception();
+                    }
+                    mPending.fetch_sub(1, std::memory_order_acq_rel);
+                });
+            }
+
+            void wait() {
+                while (mPending.load(std::memory_order_acquire) != 0) {
+                    if (!mPool.runPendingTask()) std::this_thread::yield();
+                }
+                if (mError) std::rethrow_exception(goose::exchange(mError, nullptr));
+            }
+        private:
+            threadPool& mPool;
+            std::atomic<size_t> mPending{0};
+            std::mutex mErrorLock;
+            std::exception_ptr mError;
+    };
+
+    // Calls body(chunkBegin, chunkEnd) over [begin, end), splitting recursively until pieces are
+    // no larger than grain. Halves are pushed to the pool so idle workers can steal them.
+    template<typename F>
+    void parallelFor(threadPool& pool, size_t begin, size_t end, size_t grain, F&& body) {
+        if (grain == 0) grain = 1;
+        if (end - begin <= grain) {
+            if (begin != end) body(begin, end);
+            return;
+        }
+        taskGroup group(pool);
+        auto split = [&group, &body, grain](auto& self, size_t first, size_t last) -> void {
+            while (last - first > grain) {
+                size_t mid = first + (last - first) / 2;
+                group.run([&self, mid, last] { self(self, mid, last); });
+                last = mid;
+            }
+            body(first, last);
+        };
+        split(split, begin, end);
+        group.wait();
+    }
+}
@@ -1,12 +1,213 @@
 #pragma once
 
+#include "iterator.hpp"
 #include "type_traits.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace goose {
+    template<typename T>
+    struct numRangeParts;
+
+    // Integer range [begin, end) walked in steps of step, which may be negative. Iterators carry
+    // an element index and compute values from it, so a range-for over a numRange compiles to
+    // the same counted loop as a hand-written index loop and vectorizes the same way.
+    template<typename T = size_t>
     struct numRange {
-       // TODO 
+        static_assert(std::is_integral_v<T>, "numRange is for integer types");
+        public:
+            using valueType = T;
+            using sizeType = size_t;
+            using stepType = std::make_signed_t<T>;
+
+            struct iterator {
+                public:
+                    using valueType = T;
+                    using differenceType = std::ptrdiff_t;
+                    using reference = T;
+                    using pointer = void;
+                    using iteratorCategory = randomAccessIteratorTag;
+                public:
+                    constexpr iterator() noexcept = default;
+                    constexpr iterator(T first, stepType step, sizeType index) noexcept
+                        : mFirst{first}, mStep{step}, mIndex{index} {}
+
+                    constexpr T operator*() const noexcept { return valueAt(mIndex); }
+                    constexpr T operator[](differenceType n) const noexcept { return valueAt(mIndex + n); }
+
+                    constexpr iterator& operator++() noexcept { ++mIndex; return *this; }
+                    constexpr iterator operator++(int) noexcept { auto tmp = *this; ++mIndex; return tmp; }
+                    constexpr iterator& operator--() noexcept { --mIndex; return *this; }
+                    constexpr iterator operator--(int) noexcept { auto tmp = *this; --mIndex; return tmp; }
+                    constexpr iterator& operator+=(differenceType n) noexcept { mIndex += n; return *this; }
+                    constexpr iterator& operator-=(differenceType n) noexcept { mIndex -= n; return *this; }
+
+                    friend constexpr iterator operator+(iterator it, differenceType n) noexcept { return it += n; }
+                    friend constexpr iterator operator+(differenceType n, iterator it) noexcept { return it += n; }
+                    friend constexpr iterator operator-(iterator it, differenceType n) noexcept { return it -= n; }
+                    friend constexpr differenceType operator-(iterator lhs, iterator rhs) noexcept {
+                        return static_cast<differenceType>(lhs.mIndex - rhs.mIndex);
+                    }
+
+                    friend constexpr bool operator==(iterator lhs, iterator rhs) noexcept { return lhs.mIndex == rhs.mIndex; }
+                    friend constexpr bool operator!=(iterator lhs, iterator rhs) noexcept { return lhs.mIndex != rhs.mIndex; }
+                    friend constexpr bool operator<(iterator lhs, iterator rhs) noexcept { return lhs.mIndex < rhs.mIndex; }
+                    friend constexpr bool operator>(iterator lhs, iterator rhs) noexcept { return lhs.mIndex > rhs.mIndex; }
+                    friend constexpr bool operator<=(iterator lhs, iterator rhs) noexcept { return lhs.mIndex <= rhs.mIndex; }
+                    friend constexpr bool operator>=(iterator lhs, iterator rhs) noexcept { return lhs.mIndex >= rhs.mIndex; }
+                private:
+                    // Unsigned arithmetic wraps, which is what a negative step over an unsigned T needs.
+                    constexpr T valueAt(sizeType index) const noexcept {
+                        using U = std::make_unsigned_t<T>;
+                        return static_cast<T>(static_cast<U>(mFirst) + static_cast<U>(index) * static_cast<U>(mStep));
+                    }
+
+                    T mFirst{};
+                    stepType mStep{1};
+                    sizeType mIndex{0};
+            };
+        public:
+            constexpr numRange() noexcept = default;
+            constexpr explicit numRange(T end) noexcept : numRange(T{}, end, 1) {}
+            // A zero step gives an empty range.
+            constexpr numRange(T begin, T end, stepType step = 1) noexcept
+                : mFirst{begin}, mStep{step}, mCount{countOf(begin, end, step)} {}
+        public:
+            constexpr iterator begin() const noexcept { return {mFirst, mStep, 0}; }
+            constexpr iterator end() const noexcept { return {mFirst, mStep, mCount}; }
+
+            constexpr T operator[](sizeType index) const noexcept { return begin()[index]; }
+            constexpr T front() const noexcept { return mFirst; }
+            constexpr T back() const noexcept { return begin()[mCount - 1]; }
+            constexpr stepType step() const noexcept { return mStep; }
+            constexpr sizeType size() const noexcept { return mCount; }
+            constexpr bool empty() const noexcept { return mCount == 0; }
+
+            // The elements from position first up to, but not including, position last.
+            constexpr numRange subrange(sizeType first, sizeType last) const noexcept {
+                numRange part;
+                part.mFirst = (*this)[first];
+                part.mStep = mStep;
+                part.mCount = last - first;
+                return part;
+            }
+
+            // parts pieces whose sizes differ by at most one, for handing to that many workers.
+            constexpr numRangeParts<T> split(sizeType parts) const noexcept;
+            // Pieces of size elements each; the last one takes whatever is left over.
+            constexpr numRangeParts<T> chunks(sizeType size) const noexcept;
+        private:
+            static constexpr sizeType countOf(T begin, T end, stepType step) noexcept {
+                if (step > 0 && begin < end) {
+                    auto width = static_cast<sizeType>(static_cast<std::make_unsigned_t<T>>(end - begin));
+                    return (width - 1) / static_cast<sizeType>(step) + 1;
+                }
+                if (step < 0 && begin > end) {
+                    auto width = static_cast<sizeType>(static_cast<std::make_unsigned_t<T>>(begin - end));
+                    return (width - 1) / (static_cast<sizeType>(-(step + 1)) + 1) + 1;
+                }
+                return 0;
+            }
+
+            T mFirst{};
+            stepType mStep{1};
+            sizeType mCount{0};
+    };
+
+    // Mixed bounds such as numRange(0, v.size()) take their common type.
+    template<typename T>
+    numRange(T) -> numRange<T>;
+    template<typename B, typename E>
+    numRange(B, E) -> numRange<std::common_type_t<B, E>>;
+    template<typename B, typename E, typename S>
+    numRange(B, E, S) -> numRange<std::common_type_t<B, E>>;
+
+    // Random-access sequence of contiguous numRanges covering a numRange, as made by split() and
+    // chunks(). Piece k starts at k * base + min(k, extra) elements into the range.
+    template<typename T>
+    struct numRangeParts {
+        public:
+            using valueType = numRange<T>;
+            using sizeType = size_t;
+
+            struct iterator {
+                public:
+                    using valueType = numRange<T>;
+                    using differenceType = std::ptrdiff_t;
+                    using reference = numRange<T>;
+                    using pointer = void;
+                    using iteratorCategory = randomAccessIteratorTag;
+                public:
+                    constexpr iterator() noexcept = default;
+                    constexpr iterator(const numRangeParts* parts, sizeType index) noexcept : mParts{parts}, mIndex{index} {}
+
+                    constexpr numRange<T> operator*() const noexcept { return (*mParts)[mIndex]; }
+                    constexpr numRange<T> operator[](differenceType n) const noexcept { return (*mParts)[mIndex + n]; }
+
+                    constexpr iterator& operator++() noexcept { ++mIndex; return *this; }
+                    constexpr iterator operator++(int) noexcept { auto tmp = *this; ++mIndex; return tmp; }
+                    constexpr iterator& operator--() noexcept { --mIndex; return *this; }
+                    constexpr iterator operator--(int) noexcept { auto tmp = *this; --mIndex; return tmp; }
+                    constexpr iterator& operator+=(differenceType n) noexcept { mIndex += n; return *this; }
+                    constexpr iterator& operator-=(differenceType n) noexcept { mIndex -= n; return *this; }
+
+                    friend constexpr iterator operator+(iterator it, differenceType n) noexcept { return it += n; }
+                    friend constexpr iterator operator+(differenceType n, iterator it) noexcept { return it += n; }
+                    friend constexpr iterator operator-(iterator it, differenceType n) noexcept { return it -= n; }
+                    friend constexpr differenceType operator-(iterator lhs, iterator rhs) noexcept {
+                        return static_cast<differenceType>(lhs.mIndex - rhs.mIndex);
+                    }
+
+                    friend constexpr bool operator==(iterator lhs, iterator rhs) noexcept { return lhs.mIndex == rhs.mIndex; }
+                    friend constexpr bool operator!=(iterator lhs, iterator rhs) noexcept { return lhs.mIndex != rhs.mIndex; }
+                    friend constexpr bool operator<(iterator lhs, iterator rhs) noexcept { return lhs.mIndex < rhs.mIndex; }
+                    friend constexpr bool operator>(iterator lhs, iterator rhs) noexcept { return lhs.mIndex > rhs.mIndex; }
+                    friend constexpr bool operator<=(iterator lhs, iterator rhs) noexcept { return lhs.mIndex <= rhs.mIndex; }
+                    friend constexpr bool operator>=(iterator lhs, iterator rhs) noexcept { return lhs.mIndex >= rhs.mIndex; }
+                private:
+                    const numRangeParts* mParts{nullptr};
+                    sizeType mIndex{0};
+            };
+        public:
+            constexpr numRangeParts(numRange<T> range, sizeType count, sizeType base, sizeType extra) noexcept
+                : mRange{range}, mCount{count}, mBase{base}, mExtra{extra} {}
+        public:
+            constexpr numRange<T> operator[](sizeType index) const noexcept {
+                sizeType first = startOf(index);
+                sizeType last = startOf(index + 1);
+                return mRange.subrange(first, last < mRange.size() ? last : mRange.size());
+            }
+
+            constexpr sizeType size() const noexcept { return mCount; }
+            constexpr bool empty() const noexcept { return mCount == 0; }
+
+            constexpr iterator begin() const noexcept { return {this, 0}; }
+            constexpr iterator end() const noexcept { return {this, mCount}; }
+        private:
+            constexpr sizeType startOf(sizeType index) const noexcept {
+                return index * mBase + (index < mExtra ? index : mExtra);
+            }
+
+            numRange<T> mRange;
+            sizeType mCount;
+            sizeType mBase;
+            sizeType mExtra;
     };
 
+    template<typename T>
+    constexpr numRangeParts<T> numRange<T>::split(sizeType parts) const noexcept {
+        if (parts > mCount) parts = mCount;
+        if (parts == 0) return {*this, 0, 0, 0};
+        return {*this, parts, mCount / parts, mCount % parts};
+    }
+
+    template<typename T>
+    constexpr numRangeParts<T> numRange<T>::chunks(sizeType size) const noexcept {
+        if (size == 0) size = 1;
+        return {*this, (mCount + size - 1) / size, size, 0};
+    }
+
     template<class T>
     void swap(T& a, T& b) noexcept {
         T temp = b;
@@ -2,7 +2,10 @@
 
 #include "memory.hpp"
 #include "iterator.hpp"
+#include "utility.hpp"
 #include <initializer_list>
+#include <algorithm>
+#include <type_traits>
 
 namespace goose {
     template<typename T, typename Alloc = allocator<T>>
@@ -20,31 +23,31 @@ namespace goose {
             using pointer = typename myAllocTraits::pointer;
             using constPointer = typename myAllocTraits::constPointer;
             using iterator = valueType*;
-            using constIterator = valueType*;
+            using constIterator = const valueType*;
             using reverseIterator = goose::reverseIterator<iterator>;
             using constReverseIterator = goose::reverseIterator<constIterator>;
         public:
             vector() = default;
             vector(const Alloc& alloc) : mAlloc{alloc} {}
 
-            vector(sizeType count, const T& value, const Alloc& alloc = Alloc()) : mAlloc{alloc}, mCap{count}, mSize{count} {
+            vector(sizeType count, const T& value, const Alloc& alloc = Alloc()) : mSize{count}, mCap{roundCapacity(count)}, mAlloc{alloc} {
                 mElems = myAllocTraits::allocate(mAlloc, mCap);
                 for (size_t i{}; i < mSize; ++i) {
                     myAllocTraits::construct(mAlloc, mElems + i, value);
                 }
             }
 
-            vector(sizeType count, const Alloc& alloc = Alloc()) : mAlloc{alloc}, mCap{count}, mSize{count} {
+            vector(sizeType count, const Alloc& alloc = Alloc()) : mSize{count}, mCap{roundCapacity(count)}, mAlloc{alloc} {
                 mElems = myAllocTraits::allocate(mAlloc, mCap);
                 for (size_t i{}; i < mSize; ++i) {
                     myAllocTraits::construct(mAlloc, mElems + i);
                 }
             }
 
-            template<typename InputIt>
+            template<typename InputIt, typename = enableIfT<!std::is_integral_v<InputIt>>>
             vector(InputIt first, InputIt last, const Alloc& alloc = Alloc()) : mAlloc{alloc} {
-                mCap = last - first;
-                mSize = mCap;
+                mSize = last - first;
+                mCap = roundCapacity(mSize);
                 mElems = myAllocTraits::allocate(mAlloc, mCap);
                 for (sizeType index{}; first != last; ++first, ++index) {
                     myAllocTraits::construct(mAlloc, mElems + index, *first);
@@ -52,7 +55,7 @@ namespace goose {
                 }
             }
 
-            vector(const vector& other) : mCap{other.mCap}, mSize{other.mSize}, mAlloc{other.mAlloc} {
+            vector(const vector& other) : mSize{other.mSize}, mCap{other.mCap}, mAlloc{other.mAlloc} {
                mElems = myAllocTraits::allocate(mAlloc, mCap);
                sizeType index{};
                for (auto &item : other) {
@@ -61,7 +64,7 @@ namespace goose {
                }
             }
 
-            vector(const vector& other, const Alloc& alloc) : mCap{other.mCap}, mSize{other.mSize}, mAlloc{alloc} {
+            vector(const vector& other, const Alloc& alloc) : mSize{other.mSize}, mCap{other.mCap}, mAlloc{alloc} {
                mElems = myAllocTraits::allocate(mAlloc, mCap);
                sizeType index{};
                for (auto &item : other) {
@@ -70,27 +73,25 @@ namespace goose {
                }
             }
 
-            vector(vector&& other) : mCap{exchange(other.mCap, 0)}, mSize{exchange(other.mSize, 0)}, mAlloc{std::move(other.mAlloc)} {
-               mElems = myAllocTraits::allocate(mAlloc, mCap);
-               sizeType index{};
-               for (auto &item : other) {
-                   myAllocTraits::construct(mAlloc, mElems + index, std::move(item));
-                   ++index;
-               }
-            }
+            vector(vector&& other) noexcept
+                : mElems{goose::exchange(other.mElems, nullptr)}, mSize{goose::exchange(other.mSize, 0)},
+                  mCap{goose::exchange(other.mCap, 0)}, mAlloc{std::move(other.mAlloc)} {}
 
-            vector(vector&& other, const Alloc& alloc) : mCap{exchange(other.mCap, 0)}, mSize{exchange(other.mSize, 0)}, mAlloc{alloc} {
-               mElems = myAllocTraits::allocate(mAlloc, mCap);
-               sizeType index{};
-               for (auto &item : other) {
-                   myAllocTraits::construct(mAlloc, mElems + index, std::move(item));
-                   ++index;
-               }
+            vector(vector&& other, const Alloc& alloc) : mAlloc{alloc} {
+                if constexpr (myAllocTraits::isAlwaysEqual::value) {
+                    stealFrom(other);
+                } else {
+                    if (mAlloc == other.mAlloc) {
+                        stealFrom(other);
+                    } else {
+                        moveElementsFrom(other);
+                    }
+                }
             }
 
             vector(std::initializer_list<T> list, const Alloc& alloc = Alloc()) : 
-                mAlloc{alloc}, mCap{list.size()}, mSize{list.size()} {
-                    mElems = myAllocTraits::allocate(mAlloc, list.size());
+                mSize{list.size()}, mCap{roundCapacity(list.size())}, mAlloc{alloc} {
+                    mElems = myAllocTraits::allocate(mAlloc, mCap);
                     size_t index = 0;
                     for(auto &item : list) {
                         myAllocTraits::construct(mAlloc, mElems + index, item);
@@ -99,10 +100,64 @@ namespace goose {
             }
 
             ~vector() {
-                for(size_t i{}; i < mSize; ++i) myAllocTraits::destroy(mAlloc, mElems + i);
-                myAllocTraits::deallocate(mAlloc, mElems, mCap);
+                clear();
+                if (mElems) myAllocTraits::deallocate(mAlloc, mElems, mCap);
+            }
+
+            vector& operator=(const vector& other) {
+                if (this == &other) return *this;
+                if constexpr (myAllocTraits::propagateOnContainerCopyAssignment::value) {
+                    if (mAlloc != other.mAlloc) {
+                        releaseStorage();
+                    }
+                    mAlloc = other.mAlloc;
+                }
+                assign(other.begin(), other.end());
+                return *this;
+            }
+
+            vector& operator=(vector&& other) noexcept(myAllocTraits::propagateOnContainerMoveAssignment::value
+                                                       || myAllocTraits::isAlwaysEqual::value) {
+                if (this == &other) return *this;
+                if constexpr (myAllocTraits::propagateOnContainerMoveAssignment::value) {
+                    releaseStorage();
+                    mAlloc = std::move(other.mAlloc);
+                    stealFrom(other);
+                } else if constexpr (myAllocTraits::isAlwaysEqual::value) {
+                    releaseStorage();
+                    stealFrom(other);
+                } else {
+                    if (mAlloc == other.mAlloc) {
+                        releaseStorage();
+                        stealFrom(other);
+                    } else {
+                        // Memory from other's allocator cannot be handed to ours, so fall back to moving each element.
+                        clear();
+                        moveElementsFrom(other);
+                    }
+                }
+                return *this;
+            }
+
+            vector& operator=(std::initializer_list<T> list) {
+                assign(list.begin(), list.end());
+                return *this;
             }
 
+        public:
+            reference operator[](sizeType pos) noexcept { return mElems[pos]; }
+            constReference operator[](sizeType pos) const noexcept { return mElems[pos]; }
+            reference at(sizeType pos) noexcept { return mElems[pos]; }
+            constReference at(sizeType pos) const noexcept { return mElems[pos]; }
+
+            reference front() noexcept { return mElems[0]; }
+            constReference front() const noexcept { return mElems[0]; }
+
+            reference back() noexcept { return mElems[mSize - 1]; }
+            constReference back() const noexcept { return mElems[mSize - 1]; }
+
+            T* data() noexcept { return mElems; }
+            const T* data() const noexcept { return mElems; }
         public:
             iterator begin() { return mElems; }
             constIterator begin() const { return cbegin(); }
@@ -110,19 +165,367 @@ namespace goose {
             iterator end() { return mElems + mSize; }
             constIterator end() const { return cend(); }
             constIterator cend() const { return mElems + mSize; }
+            reverseIterator rbegin() { return end(); }
+            reverseIterator rend() { return begin(); }
+            constReverseIterator rbegin() const { return crbegin(); }
+            constReverseIterator rend() const { return crend(); }
+            constReverseIterator crbegin() const { return cend(); }
+            constReverseIterator crend() const { return cbegin(); }
         public:
             sizeType size() const { return mSize; }
             sizeType capacity() const { return mCap; }
             bool empty() const { return mSize == 0; }
         public:
-            void swap(const vector& other) {
+            void reserve(sizeType newCap) {
+                if (newCap > mCap) reallocate(roundCapacity(newCap));
+            }
+
+            void shrinkToFit() {
+                if (roundCapacity(mSize) == mCap) return;
+                if (mSize == 0) {
+                    myAllocTraits::deallocate(mAlloc, mElems, mCap);
+                    mElems = nullptr;
+                    mCap = 0;
+                    return;
+                }
+                reallocate(roundCapacity(mSize));
+            }
+
+            void clear() noexcept {
+                destroyRange(mElems, mElems + mSize);
+                mSize = 0;
+            }
+
+            void pushBack(const T& value) { emplaceBack(value); }
+            void pushBack(T&& value) { emplaceBack(std::move(value)); }
+
+            template<typename... Args>
+            reference emplaceBack(Args&&... args) {
+                if (mSize == mCap) {
+                    // The new element is built before the old ones are relocated, so args may alias
+                    // an element of this vector and a throwing constructor leaves us untouched.
+                    sizeType newCap = nextCapacity(mSize + 1);
+                    T* newElems = myAllocTraits::allocate(mAlloc, newCap);
+                    try {
+                        myAllocTraits::construct(mAlloc, newElems + mSize, std::forward<Args>(args)...);
+                    } catch (...) {
+                        myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                        throw;
+                    }
+                    try {
+                        relocate(mElems, mElems + mSize, newElems);
+                    } catch (...) {
+                        myAllocTraits::destroy(mAlloc, newElems + mSize);
+                        myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                        throw;
+                    }
+                    replaceStorage(newElems, newCap);
+                } else {
+                    myAllocTraits::construct(mAlloc, mElems + mSize, std::forward<Args>(args)...);
+                }
+                ++mSize;
+                return back();
+            }
+
+            void popBack() {
+                --mSize;
+                myAllocTraits::destroy(mAlloc, mElems + mSize);
+            }
+
+            void resize(sizeType count) {
+                if (count < mSize) {
+                    destroyRange(mElems + count, mElems + mSize);
+                    mSize = count;
+                    return;
+                }
+                if (count > mCap) reallocate(nextCapacity(count));
+                sizeType index = mSize;
+                try {
+                    for (; index < count; ++index) myAllocTraits::construct(mAlloc, mElems + index);
+                } catch (...) {
+                    destroyRange(mElems + mSize, mElems + index);
+                    throw;
+                }
+                mSize = count;
+            }
+
+            void resize(sizeType count, const T& value) {
+                if (count < mSize) {
+                    destroyRange(mElems + count, mElems + mSize);
+                    mSize = count;
+                    return;
+                }
+                if (count > mCap) {
+                    // value may live inside the buffer we are about to release
+                    T copy(value);
+                    reallocate(nextCapacity(count));
+                    appendCopies(count - mSize, copy);
+                } else {
+                    appendCopies(count - mSize, value);
+                }
+            }
+
+            template<typename... Args>
+            iterator emplace(constIterator pos, Args&&... args) {
+                sizeType index = pos - cbegin();
+                if (index == mSize) {
+                    emplaceBack(std::forward<Args>(args)...);
+                    return begin() + index;
+                }
+                if (mSize == mCap) {
+                    sizeType newCap = nextCapacity(mSize + 1);
+                    T* newElems = myAllocTraits::allocate(mAlloc, newCap);
+                    try {
+                        myAllocTraits::construct(mAlloc, newElems + index, std::forward<Args>(args)...);
+                    } catch (...) {
+                        myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                        throw;
+                    }
+                    relocateAround(newElems, newCap, index, 1);
+                } else {
+                    T tmp(std::forward<Args>(args)...);
+                    openGap(index);
+                    mElems[index] = std::move(tmp);
+                }
+                ++mSize;
+                return begin() + index;
+            }
+
+            iterator insert(constIterator pos, const T& value) { return emplace(pos, value); }
+            iterator insert(constIterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+            iterator insert(constIterator pos, sizeType count, const T& value) {
+                sizeType index = pos - cbegin();
+                if (count == 0) return begin() + index;
+                if (mSize + count > mCap) {
+                    sizeType newCap = nextCapacity(mSize + count);
+                    T* newElems = myAllocTraits::allocate(mAlloc, newCap);
+                    sizeType built{};
+                    try {
+                        for (; built < count; ++built) myAllocTraits::construct(mAlloc, newElems + index + built, value);
+                    } catch (...) {
+                        destroyRange(newElems + index, newElems + index + built);
+                        myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                        throw;
+                    }
+                    relocateAround(newElems, newCap, index, count);
+                    mSize += count;
+                } else {
+                    sizeType oldSize = mSize;
+                    appendCopies(count, value);
+                    rotateTail(index, oldSize);
+                }
+                return begin() + index;
+            }
+
+            template<typename InputIt, typename = enableIfT<!std::is_integral_v<InputIt>>>
+            iterator insert(constIterator pos, InputIt first, InputIt last) {
+                sizeType index = pos - cbegin();
+                sizeType count = last - first;
+                if (count == 0) return begin() + index;
+                if (mSize + count > mCap) {
+                    sizeType newCap = nextCapacity(mSize + count);
+                    T* newElems = myAllocTraits::allocate(mAlloc, newCap);
+                    sizeType built{};
+                    try {
+                        for (; built < count; ++built, ++first) myAllocTraits::construct(mAlloc, newElems + index + built, *first);
+                    } catch (...) {
+                        destroyRange(newElems + index, newElems + index + built);
+                        myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                        throw;
+                    }
+                    relocateAround(newElems, newCap, index, count);
+                    mSize += count;
+                } else {
+                    sizeType oldSize = mSize;
+                    sizeType built = mSize;
+                    try {
+                        for (; first != last; ++first, ++built) myAllocTraits::construct(mAlloc, mElems + built, *first);
+                    } catch (...) {
+                        destroyRange(mElems + oldSize, mElems + built);
+                        throw;
+                    }
+                    mSize = built;
+                    rotateTail(index, oldSize);
+                }
+                return begin() + index;
+            }
+
+            iterator insert(constIterator pos, std::initializer_list<T> list) {
+                return insert(pos, list.begin(), list.end());
+            }
+
+            iterator erase(constIterator pos) {
+                return erase(pos, pos + 1);
+            }
+
+            iterator erase(constIterator first, constIterator last) {
+                iterator dst = begin() + (first - cbegin());
+                if (first == last) return dst;
+                iterator src = begin() + (last - cbegin());
+                iterator out = dst;
+                for (; src != end(); ++src, ++out) *out = std::move(*src);
+                destroyRange(out, end());
+                mSize = out - begin();
+                return dst;
+            }
+
+            template<typename InputIt, typename = enableIfT<!std::is_integral_v<InputIt>>>
+            void assign(InputIt first, InputIt last) {
+                clear();
+                sizeType count = last - first;
+                if (count > mCap) {
+                    sizeType newCap = nextCapacity(count);
+                    releaseStorage();
+                    reallocate(newCap);
+                }
+                for (; first != last; ++first, ++mSize) myAllocTraits::construct(mAlloc, mElems + mSize, *first);
+            }
+
+            void swap(vector& other) noexcept {
+                goose::swap(mElems, other.mElems);
+                goose::swap(mSize, other.mSize);
+                goose::swap(mCap, other.mCap);
+                if constexpr (myAllocTraits::propagateOnContainerSwap::value) {
+                    goose::swap(mAlloc, other.mAlloc);
+                }
+            }
+        private:
+            static constexpr bool moveRelocates = std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+
+            sizeType nextCapacity(sizeType required) const {
+                sizeType grown = mCap * growthFactor;
+                if (grown < required) grown = required;
+                return roundCapacity(grown);
+            }
+
+            // Pads to the allocator's capacityGranule; see alignedAllocator.
+            static constexpr sizeType roundCapacity(sizeType count) noexcept {
+                constexpr sizeType granule = myAllocTraits::capacityGranule;
+                if constexpr (granule == 1) return count;
+                else return (count + granule - 1) / granule * granule;
+            }
+
+            void destroyRange(T* first, T* last) noexcept {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (; first != last; ++first) myAllocTraits::destroy(mAlloc, first);
+                }
+            }
 
+            // Constructs [first, last) into dst, moving when that cannot throw and copying otherwise.
+            // On failure everything constructed so far is destroyed and the source is left intact.
+            void relocate(T* first, T* last, T* dst) {
+                T* out = dst;
+                try {
+                    for (; first != last; ++first, ++out) {
+                        if constexpr (moveRelocates) {
+                            myAllocTraits::construct(mAlloc, out, std::move(*first));
+                        } else {
+                            myAllocTraits::construct(mAlloc, out, *first);
+                        }
+                    }
+                } catch (...) {
+                    destroyRange(dst, out);
+                    throw;
+                }
+            }
+
+            void replaceStorage(T* newElems, sizeType newCap) noexcept {
+                destroyRange(mElems, mElems + mSize);
+                if (mElems) myAllocTraits::deallocate(mAlloc, mElems, mCap);
+                mElems = newElems;
+                mCap = newCap;
+            }
+
+            void reallocate(sizeType newCap) {
+                T* newElems = myAllocTraits::allocate(mAlloc, newCap);
+                try {
+                    relocate(mElems, mElems + mSize, newElems);
+                } catch (...) {
+                    myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                    throw;
+                }
+                replaceStorage(newElems, newCap);
+            }
+
+            // newElems already holds `count` constructed elements at [index, index + count);
+            // moves the current elements around them and adopts the new buffer.
+            void relocateAround(T* newElems, sizeType newCap, sizeType index, sizeType count) {
+                try {
+                    relocate(mElems, mElems + index, newElems);
+                    try {
+                        relocate(mElems + index, mElems + mSize, newElems + index + count);
+                    } catch (...) {
+                        destroyRange(newElems, newElems + index);
+                        throw;
+                    }
+                } catch (...) {
+                    destroyRange(newElems + index, newElems + index + count);
+                    myAllocTraits::deallocate(mAlloc, newElems, newCap);
+                    throw;
+                }
+                replaceStorage(newElems, newCap);
+            }
+
+            // Shifts [index, mSize) right by one slot within the current capacity, leaving a
+            // moved-from object at index ready to be assigned.
+            void openGap(sizeType index) {
+                myAllocTraits::construct(mAlloc, mElems + mSize, std::move(mElems[mSize - 1]));
+                for (sizeType i = mSize - 1; i > index; --i) {
+                    mElems[i] = std::move(mElems[i - 1]);
+                }
+            }
+
+            // Appends the new elements at the end, then rotates them into place at index.
+            void rotateTail(sizeType index, sizeType oldSize) {
+                std::rotate(mElems + index, mElems + oldSize, mElems + mSize);
+            }
+
+            void releaseStorage() noexcept {
+                clear();
+                if (mElems) myAllocTraits::deallocate(mAlloc, mElems, mCap);
+                mElems = nullptr;
+                mCap = 0;
+            }
+
+            void stealFrom(vector& other) noexcept {
+                mElems = goose::exchange(other.mElems, nullptr);
+                mSize = goose::exchange(other.mSize, 0);
+                mCap = goose::exchange(other.mCap, 0);
+            }
+
+            // Moves other's elements into storage from our own allocator; other keeps its buffer, now emptied.
+            void moveElementsFrom(vector& other) {
+                reserve(other.mSize);
+                for (; mSize < other.mSize; ++mSize) {
+                    myAllocTraits::construct(mAlloc, mElems + mSize, std::move(other.mElems[mSize]));
+                }
+                other.clear();
+            }
+
+            void appendCopies(sizeType count, const T& value) {
+                sizeType index = mSize;
+                try {
+                    for (sizeType i{}; i < count; ++i, ++index) myAllocTraits::construct(mAlloc, mElems + index, value);
+                } catch (...) {
+                    destroyRange(mElems + mSize, mElems + index);
+                    throw;
+                }
+                mSize = index;
             }
         private:
-            T* mElems;
-            sizeType mSize;
-            sizeType mCap;
+            T* mElems{nullptr};
+            sizeType mSize{0};
+            sizeType mCap{0};
             Alloc mAlloc;
     };
-    
+
+    template<typename T, typename Alloc>
+    void swap(vector<T, Alloc>& lhs, vector<T, Alloc>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    // Cache-line aligned storage whose capacity is always a whole number of Align-byte blocks.
+    template<typename T, size_t Align = 64>
+    using simdVector = vector<T, simdAllocator<T, Align>>;
 } 